@@ -7,2093 +7,10340 @@
 
 #include <iostream> 
 #include <fstream>   // read json from file 
-#include <sstream>   // string buffer
-#include <cmath>     // pow
+#include <cstring>   // strlen
+#include <cwchar>    // wcslen
+#include <cmath>     // HUGE_VAL
+#include <cstdlib>   // strtod, strtold
+#include <cstdio>    // snprintf
+#include <cerrno>    // EINTR
+#include <stdexcept> // range_error
 #include <queue>     // token container
 #include <string>    // string and wstring
-#include <map>       // json object container
+#include <utility>   // json object member pair
 #include <vector>    // array container
 #include <locale>    // ucs utf8 convertor
 #include <codecvt>   // ucs utf8 convertor
 #include <memory>    // smart pointer
+#include <cstdint>   // fixed width integer
+#include <cstddef>   // max_align_t
+#include <type_traits> // make_unsigned
+#include <algorithm> // max
+#include <limits>    // numeric_limits
+#include <atomic>    // key reference count
+#include <new>       // placement new
+
+// SIMD support, x86 SSE2 is used when compiler targets it and AVX2 is
+// selected at runtime if the cpu supports it. Define
+// OCTILLION_JSONW_DISABLE_SIMD to always use the scalar implementation.
+#if !defined(OCTILLION_JSONW_DISABLE_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCTILLION_JSONW_SSE2
+#include <emmintrin.h> // sse2 intrinsics
+#endif
+#if defined(OCTILLION_JSONW_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define OCTILLION_JSONW_AVX2
+#include <immintrin.h> // avx2 intrinsics
+#endif
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>    // _BitScanForward
+#endif
+
+// Json lines are parsed by worker threads. Define
+// OCTILLION_JSONW_DISABLE_THREAD to parse them in the caller thread.
+#if !defined(OCTILLION_JSONW_DISABLE_THREAD)
+#include <thread>              // worker thread
+#include <mutex>               // worker synchronization
+#include <condition_variable>  // worker synchronization
+#include <deque>               // batch queue
+#endif
+
+// Serialized text can be written into a file descriptor on POSIX system.
+#if defined(__unix__) || defined(__APPLE__)
+#define OCTILLION_JSONW_POSIX
+#include <unistd.h>    // write
+#endif
+
+// Json file is memory mapped on POSIX system. Define
+// OCTILLION_JSONW_DISABLE_MMAP to read the file into memory instead.
+#if !defined(OCTILLION_JSONW_DISABLE_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define OCTILLION_JSONW_MMAP
+#include <sys/mman.h>  // mmap
+#include <sys/stat.h>  // fstat
+#include <fcntl.h>     // open
+#include <unistd.h>    // close
+#endif
+
+// JsonSimdW scans utf8 text in 16 (SSE2) or 32 (AVX2) bytes block to skip
+// white space and plain string content in bulk. The implementation is
+// selected once at runtime, scalar one is used if cpu has no SIMD support.
+class JsonSimdW
+{
+public:
+    // return the first non white space character in [cur, end)
+    static const char* skipspace(const char* cur, const char* end)
+    {
+        return dispatch().skipspace(cur, end);
+    }
+
+    // return the first character in [cur, end) that cannot be copied into
+    // string as it is, which are \", \\, \r, \n and non-ascii character
+    static const char* findspecial(const char* cur, const char* end)
+    {
+        return dispatch().findspecial(cur, end);
+    }
+
+    // return the first character in [cur, end) that may need escaping
+    // when string is serialized, which are \", \\, / and 0x08 to 0x0D.
+    // Both ucs and utf8 string are supported.
+    static const wchar_t* findescape(const wchar_t* cur, const wchar_t* end)
+    {
+        return dispatch().findescape(cur, end);
+    }
+
+    static const char* findescape(const char* cur, const char* end)
+    {
+        return dispatch().findescape8(cur, end);
+    }
+
+    // name of the selected implementation, "avx2", "sse2" or "scalar"
+    static const char* name()
+    {
+        return dispatch().name;
+    }
+
+private:
+    struct Dispatch
+    {
+        const char* name;
+        const char* (*skipspace)(const char*, const char*);
+        const char* (*findspecial)(const char*, const char*);
+        const wchar_t* (*findescape)(const wchar_t*, const wchar_t*);
+        const char* (*findescape8)(const char*, const char*);
+    };
+
+    static const Dispatch& dispatch()
+    {
+        static const Dispatch instance = select();
+        return instance;
+    }
+
+    static Dispatch select()
+    {
+#if defined(OCTILLION_JSONW_AVX2)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            Dispatch avx2 = { "avx2", skipspace_avx2, findspecial_avx2, findescape_avx2, findescape8_avx2 };
+            return avx2;
+        }
+#endif
+#if defined(OCTILLION_JSONW_SSE2)
+        Dispatch sse2 = { "sse2", skipspace_sse2, findspecial_sse2, findescape_sse2, findescape8_sse2 };
+        return sse2;
+#else
+        Dispatch scalar = { "scalar", skipspace_scalar, findspecial_scalar, findescape_scalar, findescape8_scalar };
+        return scalar;
+#endif
+    }
+
+    // index of the lowest set bit, mask cannot be zero
+    static int lowestbit(unsigned int mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (int)index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    static const char* skipspace_scalar(const char* cur, const char* end)
+    {
+        while (cur < end && (*cur == ' ' || *cur == '\n' || *cur == '\r' || *cur == '\t'))
+        {
+            cur++;
+        }
+        return cur;
+    }
+
+    static const char* findspecial_scalar(const char* cur, const char* end)
+    {
+        while (cur < end)
+        {
+            unsigned char character = (unsigned char)*cur;
+            if (character == '\"' || character == '\\' || character == '\r' ||
+                character == '\n' || character >= 0x80)
+            {
+                break;
+            }
+            cur++;
+        }
+        return cur;
+    }
+
+    static const wchar_t* findescape_scalar(const wchar_t* cur, const wchar_t* end)
+    {
+        while (cur < end)
+        {
+            wchar_t wchar = *cur;
+            if (wchar == L'\"' || wchar == L'\\' || wchar == L'/' ||
+                (wchar >= 0x08 && wchar <= 0x0D))
+            {
+                break;
+            }
+            cur++;
+        }
+        return cur;
+    }
+
+    static const char* findescape8_scalar(const char* cur, const char* end)
+    {
+        while (cur < end)
+        {
+            char character = *cur;
+            if (character == '\"' || character == '\\' || character == '/' ||
+                (character >= 0x08 && character <= 0x0D))
+            {
+                break;
+            }
+            cur++;
+        }
+        return cur;
+    }
+
+#if defined(OCTILLION_JSONW_SSE2)
+    static const char* skipspace_sse2(const char* cur, const char* end)
+    {
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+
+        while (end - cur >= 16)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)cur);
+            __m128i ws = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)),
+                _mm_or_si128(_mm_cmpeq_epi8(block, lf), _mm_cmpeq_epi8(block, cr)));
+            unsigned int mask = ~(unsigned int)_mm_movemask_epi8(ws) & 0xFFFF;
+
+            if (mask != 0)
+            {
+                return cur + lowestbit(mask);
+            }
+            cur += 16;
+        }
+
+        return skipspace_scalar(cur, end);
+    }
+
+    static const char* findspecial_sse2(const char* cur, const char* end)
+    {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+
+        while (end - cur >= 16)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)cur);
+            __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)),
+                _mm_or_si128(_mm_cmpeq_epi8(block, lf), _mm_cmpeq_epi8(block, cr)));
+
+            // the sign bit of each byte is set for non-ascii character
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(special, block));
+
+            if (mask != 0)
+            {
+                return cur + lowestbit(mask);
+            }
+            cur += 16;
+        }
+
+        return findspecial_scalar(cur, end);
+    }
+
+    // wchar_t is 4 bytes on linux and 2 bytes on windows, the lane width
+    // follows it. Signed compare is fine since character is below 0x110000
+    // and a 2 bytes lane above 0x7FFF is never in range 0x08 to 0x0D.
+    static const wchar_t* findescape_sse2(const wchar_t* cur, const wchar_t* end)
+    {
+#if WCHAR_MAX > 0xFFFF
+#define OCTILLION_JSONW_SET1 _mm_set1_epi32
+#define OCTILLION_JSONW_CMPEQ _mm_cmpeq_epi32
+#define OCTILLION_JSONW_CMPGT _mm_cmpgt_epi32
+#else
+#define OCTILLION_JSONW_SET1 _mm_set1_epi16
+#define OCTILLION_JSONW_CMPEQ _mm_cmpeq_epi16
+#define OCTILLION_JSONW_CMPGT _mm_cmpgt_epi16
+#endif
+        const size_t lanes = 16 / sizeof(wchar_t);
+        const __m128i quote = OCTILLION_JSONW_SET1('\"');
+        const __m128i backslash = OCTILLION_JSONW_SET1('\\');
+        const __m128i slash = OCTILLION_JSONW_SET1('/');
+        const __m128i low = OCTILLION_JSONW_SET1(0x07);
+        const __m128i high = OCTILLION_JSONW_SET1(0x0E);
+
+        while ((size_t)(end - cur) >= lanes)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)cur);
+            __m128i special = _mm_or_si128(
+                _mm_or_si128(OCTILLION_JSONW_CMPEQ(block, quote), OCTILLION_JSONW_CMPEQ(block, backslash)),
+                _mm_or_si128(OCTILLION_JSONW_CMPEQ(block, slash),
+                    _mm_and_si128(OCTILLION_JSONW_CMPGT(block, low), OCTILLION_JSONW_CMPGT(high, block))));
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(special);
+
+            if (mask != 0)
+            {
+                return cur + lowestbit(mask) / sizeof(wchar_t);
+            }
+            cur += lanes;
+        }
+#undef OCTILLION_JSONW_SET1
+#undef OCTILLION_JSONW_CMPEQ
+#undef OCTILLION_JSONW_CMPGT
+
+        return findescape_scalar(cur, end);
+    }
+
+    // utf8 lead and trail bytes are negative in signed compare, they are
+    // never in range 0x08 to 0x0D
+    static const char* findescape8_sse2(const char* cur, const char* end)
+    {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i slash = _mm_set1_epi8('/');
+        const __m128i low = _mm_set1_epi8(0x07);
+        const __m128i high = _mm_set1_epi8(0x0E);
+
+        while (end - cur >= 16)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)cur);
+            __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)),
+                _mm_or_si128(_mm_cmpeq_epi8(block, slash),
+                    _mm_and_si128(_mm_cmpgt_epi8(block, low), _mm_cmpgt_epi8(high, block))));
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(special);
+
+            if (mask != 0)
+            {
+                return cur + lowestbit(mask);
+            }
+            cur += 16;
+        }
+
+        return findescape8_scalar(cur, end);
+    }
+#endif
+
+#if defined(OCTILLION_JSONW_AVX2)
+    __attribute__((target("avx2")))
+    static const char* skipspace_avx2(const char* cur, const char* end)
+    {
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        const __m256i cr = _mm256_set1_epi8('\r');
+
+        while (end - cur >= 32)
+        {
+            __m256i block = _mm256_loadu_si256((const __m256i*)cur);
+            __m256i ws = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, tab)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, lf), _mm256_cmpeq_epi8(block, cr)));
+            unsigned int mask = ~(unsigned int)_mm256_movemask_epi8(ws);
+
+            if (mask != 0)
+            {
+                return cur + lowestbit(mask);
+            }
+            cur += 32;
+        }
+
+        return skipspace_sse2(cur, end);
+    }
+
+    __attribute__((target("avx2")))
+    static const char* findspecial_avx2(const char* cur, const char* end)
+    {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        const __m256i cr = _mm256_set1_epi8('\r');
+
+        while (end - cur >= 32)
+        {
+            __m256i block = _mm256_loadu_si256((const __m256i*)cur);
+            __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, lf), _mm256_cmpeq_epi8(block, cr)));
+
+            // the sign bit of each byte is set for non-ascii character
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(special, block));
+
+            if (mask != 0)
+            {
+                return cur + lowestbit(mask);
+            }
+            cur += 32;
+        }
+
+        return findspecial_sse2(cur, end);
+    }
+
+    __attribute__((target("avx2")))
+    static const wchar_t* findescape_avx2(const wchar_t* cur, const wchar_t* end)
+    {
+#if WCHAR_MAX > 0xFFFF
+#define OCTILLION_JSONW_SET1 _mm256_set1_epi32
+#define OCTILLION_JSONW_CMPEQ _mm256_cmpeq_epi32
+#define OCTILLION_JSONW_CMPGT _mm256_cmpgt_epi32
+#else
+#define OCTILLION_JSONW_SET1 _mm256_set1_epi16
+#define OCTILLION_JSONW_CMPEQ _mm256_cmpeq_epi16
+#define OCTILLION_JSONW_CMPGT _mm256_cmpgt_epi16
+#endif
+        const size_t lanes = 32 / sizeof(wchar_t);
+        const __m256i quote = OCTILLION_JSONW_SET1('\"');
+        const __m256i backslash = OCTILLION_JSONW_SET1('\\');
+        const __m256i slash = OCTILLION_JSONW_SET1('/');
+        const __m256i low = OCTILLION_JSONW_SET1(0x07);
+        const __m256i high = OCTILLION_JSONW_SET1(0x0E);
+
+        while ((size_t)(end - cur) >= lanes)
+        {
+            __m256i block = _mm256_loadu_si256((const __m256i*)cur);
+            __m256i special = _mm256_or_si256(
+                _mm256_or_si256(OCTILLION_JSONW_CMPEQ(block, quote), OCTILLION_JSONW_CMPEQ(block, backslash)),
+                _mm256_or_si256(OCTILLION_JSONW_CMPEQ(block, slash),
+                    _mm256_and_si256(OCTILLION_JSONW_CMPGT(block, low), OCTILLION_JSONW_CMPGT(high, block))));
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(special);
+
+            if (mask != 0)
+            {
+                return cur + lowestbit(mask) / sizeof(wchar_t);
+            }
+            cur += lanes;
+        }
+#undef OCTILLION_JSONW_SET1
+#undef OCTILLION_JSONW_CMPEQ
+#undef OCTILLION_JSONW_CMPGT
+
+        return findescape_sse2(cur, end);
+    }
+
+    __attribute__((target("avx2")))
+    static const char* findescape8_avx2(const char* cur, const char* end)
+    {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i slash = _mm256_set1_epi8('/');
+        const __m256i low = _mm256_set1_epi8(0x07);
+        const __m256i high = _mm256_set1_epi8(0x0E);
+
+        while (end - cur >= 32)
+        {
+            __m256i block = _mm256_loadu_si256((const __m256i*)cur);
+            __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, slash),
+                    _mm256_and_si256(_mm256_cmpgt_epi8(block, low), _mm256_cmpgt_epi8(high, block))));
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(special);
+
+            if (mask != 0)
+            {
+                return cur + lowestbit(mask);
+            }
+            cur += 32;
+        }
+
+        return findescape8_sse2(cur, end);
+    }
+#endif
+};
+
+// JsonFloatW converts decimal number text into the nearest double. Numbers
+// up to 2^53 with small exponent are converted by one exact multiplication,
+// others by Eisel-Lemire algorithm with a 128-bit table of powers of five.
+// Number with more than 19 significant digits that Eisel-Lemire cannot
+// round falls back to strtod().
+class JsonFloatW
+{
+    friend class JsonFormatW;
+
+public:
+    // convert number text [begin, last) times 10^exponent, the text has been
+    // checked by caller. Return false if the value is out of double range.
+    template <typename CharT>
+    static bool convert(const CharT* begin, const CharT* last, int64_t exponent, double& value)
+    {
+        const CharT* cur = begin;
+        int64_t scale = exponent;
+        bool negative = false;
+        bool dot = false;
+        bool truncated = false;
+        uint64_t mantissa = 0;
+        int digits = 0;
+
+        if (*cur == '-')
+        {
+            negative = true;
+            cur++;
+        }
+
+        // keep the first 19 significant digits, the exponent is adjusted by
+        // the digits after dot and the digits dropped before dot
+        for (; cur < last; cur++)
+        {
+            if (*cur == '.')
+            {
+                dot = true;
+                continue;
+            }
+
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (uint64_t)(*cur - '0');
+                digits += mantissa == 0 ? 0 : 1;
+                exponent -= dot ? 1 : 0;
+            }
+            else
+            {
+                truncated = truncated || *cur != '0';
+                exponent += dot ? 0 : 1;
+            }
+        }
+
+        uint64_t bits;
+        if (mantissa == 0)
+        {
+            bits = 0;
+        }
+        else if (!truncated && exponent >= -22 && exponent <= 22 && mantissa <= (1ULL << 53))
+        {
+            // both mantissa and power of ten are exact in double
+            value = (double)mantissa;
+            value = exponent < 0 ? value / exact(-exponent) : value * exact(exponent);
+            value = negative ? -value : value;
+            return true;
+        }
+        else
+        {
+            bits = eiselemire(mantissa, exponent);
+
+            // the dropped digits are between mantissa and mantissa + 1
+            if (truncated && bits != eiselemire(mantissa + 1, exponent))
+            {
+                return fallback(begin, last, scale, value);
+            }
+        }
+
+        if (bits == INFINITE)
+        {
+            return false;
+        }
+
+        bits |= negative ? (1ULL << 63) : 0;
+        std::memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+
+    // convert number text out of double range into long double as stold()
+    // of the previous parser did, return false if it is out of long double
+    // range too
+    template <typename CharT>
+    static bool extended(const CharT* begin, const CharT* last, int64_t exponent, long double& value)
+    {
+        value = std::strtold(scientific(begin, last, exponent).c_str(), nullptr);
+        return value != HUGE_VALL && value != -HUGE_VALL;
+    }
+
+private:
+    // bits of infinity
+    const static uint64_t INFINITE = 0x7FFULL << 52;
+
+    // 10^exponent for 0 <= exponent <= 22
+    static double exact(int64_t exponent)
+    {
+        static const double powers[] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        return powers[exponent];
+    }
+
+    // bits of double nearest to mantissa * 10^exponent, mantissa is not zero
+    static uint64_t eiselemire(uint64_t mantissa, int64_t exponent)
+    {
+        if (exponent < -342)
+        {
+            return 0;
+        }
+        else if (exponent > 308)
+        {
+            return INFINITE;
+        }
+
+        int zeros = leadingzeros(mantissa);
+        mantissa <<= zeros;
+
+        // 128-bit product of mantissa and 5^exponent, the lower word of the
+        // power is only needed if the upper 55 bits are not certain
+        const uint64_t* power = powers() + 2 * (exponent + 342);
+        uint64_t high, low;
+        multiply(mantissa, power[0], high, low);
+
+        if ((high & 0x1FF) == 0x1FF)
+        {
+            uint64_t high2, low2;
+            multiply(mantissa, power[1], high2, low2);
+            low += high2;
+            high += low < high2 ? 1 : 0;
+        }
+
+        int upperbit = (int)(high >> 63);
+        int shift = upperbit + 64 - 52 - 3;
+        uint64_t significand = high >> shift;
+        int power2 = (int)((((152170 + 65536) * exponent) >> 16) + 63) + upperbit - zeros + 1023;
+
+        // subnormal, round to nearest after the shift
+        if (power2 <= 0)
+        {
+            if (-power2 + 1 >= 64)
+            {
+                return 0;
+            }
+
+            significand >>= -power2 + 1;
+            significand += significand & 1;
+            significand >>= 1;
+            power2 = significand < (1ULL << 52) ? 0 : 1;
+            return (significand & ((1ULL << 52) - 1)) | ((uint64_t)power2 << 52);
+        }
+
+        // exactly halfway between two doubles, round to even
+        if (low <= 1 && exponent >= -4 && exponent <= 23 && (significand & 3) == 1 &&
+            (significand << shift) == high)
+        {
+            significand &= ~1ULL;
+        }
+
+        significand += significand & 1;
+        significand >>= 1;
+
+        if (significand >= (2ULL << 52))
+        {
+            significand = 1ULL << 52;
+            power2++;
+        }
+
+        if (power2 >= 0x7FF)
+        {
+            return INFINITE;
+        }
+
+        return (significand & ((1ULL << 52) - 1)) | ((uint64_t)power2 << 52);
+    }
+
+    // convert by strtod()
+    template <typename CharT>
+    static bool fallback(const CharT* begin, const CharT* last, int64_t exponent, double& value)
+    {
+        value = std::strtod(scientific(begin, last, exponent).c_str(), nullptr);
+        return value != HUGE_VAL && value != -HUGE_VAL;
+    }
+
+    // number text for strtod() and strtold(), dot is removed so the text
+    // does not depend on the decimal point of current locale
+    template <typename CharT>
+    static std::string scientific(const CharT* begin, const CharT* last, int64_t exponent)
+    {
+        std::string text;
+
+        for (const CharT* cur = begin; cur < last; cur++)
+        {
+            if (*cur == '.')
+            {
+                exponent -= last - cur - 1;
+            }
+            else
+            {
+                text.push_back((char)*cur);
+            }
+        }
+
+        text += "e" + std::to_string(exponent);
+        return text;
+    }
+
+    // 128-bit product of a and b
+    static void multiply(uint64_t a, uint64_t b, uint64_t& high, uint64_t& low)
+    {
+#if defined(__SIZEOF_INT128__)
+        // __extension__ keeps -Wpedantic quiet about the non-standard type
+        __extension__ typedef unsigned __int128 Product;
+        Product product = (Product)a * b;
+        high = (uint64_t)(product >> 64);
+        low = (uint64_t)product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+        low = _umul128(a, b, &high);
+#else
+        uint64_t a0 = a & 0xFFFFFFFF, a1 = a >> 32;
+        uint64_t b0 = b & 0xFFFFFFFF, b1 = b >> 32;
+        uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+        uint64_t middle = (p00 >> 32) + (p01 & 0xFFFFFFFF) + (p10 & 0xFFFFFFFF);
+        high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+        low = (middle << 32) | (p00 & 0xFFFFFFFF);
+#endif
+    }
+
+    // number of leading zero bits, value cannot be zero
+    static int leadingzeros(uint64_t value)
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return 63 - (int)index;
+#elif defined(_MSC_VER)
+        int zeros = 0;
+        while ((value & (1ULL << 63)) == 0)
+        {
+            value <<= 1;
+            zeros++;
+        }
+        return zeros;
+#else
+        return __builtin_clzll(value);
+#endif
+    }
+
+    // 5^q for -342 <= q <= 308 in 128 bits, the upper word is normalized
+    // so its highest bit is set. Negative power is rounded up.
+    static const uint64_t* powers()
+    {
+        static const uint64_t table[] =
+        {
+            0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL, 0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+            0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL, 0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+            0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL, 0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+            0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL, 0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+            0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL, 0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+            0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL, 0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+            0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL, 0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+            0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL, 0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+            0x84a57695fe98746dULL, 0x014bb630f7604b57ULL, 0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+            0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL, 0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+            0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL, 0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+            0xfd00b897478238d0ULL, 0x8920b098955522b4ULL, 0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+            0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL, 0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+            0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL, 0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+            0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL, 0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+            0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL, 0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+            0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL, 0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+            0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL, 0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+            0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL, 0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+            0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL, 0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+            0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL, 0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+            0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL, 0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+            0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL, 0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+            0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL, 0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+            0xa37fce126597973cULL, 0xe50ff107bab528a0ULL, 0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+            0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL, 0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+            0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL, 0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+            0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL, 0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+            0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL, 0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+            0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL, 0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+            0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL, 0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+            0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL, 0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+            0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL, 0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+            0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL, 0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+            0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL, 0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+            0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL, 0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+            0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL, 0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+            0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL, 0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+            0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL, 0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+            0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL, 0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+            0xc987434744ac874eULL, 0xa327ffb266b56220ULL, 0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+            0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL, 0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+            0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL, 0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+            0xc0314325637a1939ULL, 0xfa911155fefb5308ULL, 0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+            0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL, 0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+            0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL, 0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+            0xb749faed14125d36ULL, 0xcef980ec671f667bULL, 0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+            0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL, 0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+            0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL, 0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+            0xaecc49914078536dULL, 0x58fae9f773886e18ULL, 0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+            0x888f99797a5e012dULL, 0x6d8406c952429603ULL, 0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+            0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL, 0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+            0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL, 0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+            0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL, 0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+            0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL, 0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+            0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL, 0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+            0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL, 0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+            0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL, 0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+            0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL, 0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+            0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL, 0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+            0xb913179899f68584ULL, 0x28e2557b59846e3fULL, 0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+            0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL, 0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+            0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL, 0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+            0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL, 0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+            0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL, 0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+            0xd77485cb25823ac7ULL, 0x7d633293366b828bULL, 0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+            0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL, 0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+            0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL, 0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+            0xcd795be870516656ULL, 0x67902e276c921f8bULL, 0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+            0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL, 0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+            0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL, 0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+            0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL, 0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+            0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL, 0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+            0xef340a98172aace4ULL, 0x86fb897116c87c34ULL, 0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+            0xbae0a846d2195712ULL, 0x8974836059cca109ULL, 0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+            0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL, 0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+            0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL, 0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+            0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL, 0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+            0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL, 0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+            0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL, 0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+            0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL, 0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+            0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL, 0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+            0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL, 0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+            0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL, 0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+            0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL, 0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+            0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL, 0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+            0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL, 0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+            0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL, 0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+            0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL, 0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+            0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL, 0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+            0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL, 0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+            0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL, 0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+            0x8c974f7383725573ULL, 0x1e414218c73a13fbULL, 0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+            0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL, 0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+            0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL, 0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+            0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL, 0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+            0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL, 0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+            0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL, 0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+            0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL, 0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+            0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL, 0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+            0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL, 0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+            0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL, 0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+            0xbe89523386091465ULL, 0xf6bbb397f1135823ULL, 0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+            0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL, 0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+            0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL, 0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+            0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL, 0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+            0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL, 0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+            0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL, 0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+            0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL, 0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+            0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL, 0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+            0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL, 0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+            0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL, 0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+            0x811ccc668829b887ULL, 0x0806357d5a3f525fULL, 0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+            0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL, 0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+            0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL, 0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+            0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL, 0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+            0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL, 0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+            0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL, 0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+            0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL, 0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+            0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL, 0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+            0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL, 0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+            0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL, 0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+            0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL, 0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+            0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL, 0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+            0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL, 0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+            0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL, 0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+            0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL, 0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+            0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL, 0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+            0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL, 0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+            0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL, 0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+            0xc24452da229b021bULL, 0xfbe85badce996168ULL, 0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+            0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL, 0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+            0xed246723473e3813ULL, 0x290123e9aab23b68ULL, 0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+            0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL, 0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+            0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL, 0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+            0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL, 0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+            0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL, 0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+            0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL, 0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+            0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL, 0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+            0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL, 0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+            0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL, 0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+            0xcdb02555653131b6ULL, 0x3792f412cb06794dULL, 0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+            0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL, 0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+            0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL, 0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+            0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL, 0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+            0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL, 0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+            0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL, 0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+            0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, 0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+            0x9226712162ab070dULL, 0xcab3961304ca70e8ULL, 0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+            0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL, 0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+            0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, 0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+            0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL, 0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+            0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL, 0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+            0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL, 0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+            0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL, 0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+            0xcfb11ead453994baULL, 0x67de18eda5814af2ULL, 0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+            0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, 0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+            0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL, 0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+            0xc612062576589ddaULL, 0x95364afe032a819eULL, 0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+            0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL, 0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+            0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL, 0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+            0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL, 0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+            0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL, 0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+            0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL, 0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+            0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL, 0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+            0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL, 0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+            0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL, 0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+            0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL, 0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+            0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL, 0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+            0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL, 0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+            0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL, 0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+            0x8000000000000000ULL, 0x0000000000000000ULL, 0xa000000000000000ULL, 0x0000000000000000ULL,
+            0xc800000000000000ULL, 0x0000000000000000ULL, 0xfa00000000000000ULL, 0x0000000000000000ULL,
+            0x9c40000000000000ULL, 0x0000000000000000ULL, 0xc350000000000000ULL, 0x0000000000000000ULL,
+            0xf424000000000000ULL, 0x0000000000000000ULL, 0x9896800000000000ULL, 0x0000000000000000ULL,
+            0xbebc200000000000ULL, 0x0000000000000000ULL, 0xee6b280000000000ULL, 0x0000000000000000ULL,
+            0x9502f90000000000ULL, 0x0000000000000000ULL, 0xba43b74000000000ULL, 0x0000000000000000ULL,
+            0xe8d4a51000000000ULL, 0x0000000000000000ULL, 0x9184e72a00000000ULL, 0x0000000000000000ULL,
+            0xb5e620f480000000ULL, 0x0000000000000000ULL, 0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+            0x8e1bc9bf04000000ULL, 0x0000000000000000ULL, 0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+            0xde0b6b3a76400000ULL, 0x0000000000000000ULL, 0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+            0xad78ebc5ac620000ULL, 0x0000000000000000ULL, 0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+            0x878678326eac9000ULL, 0x0000000000000000ULL, 0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+            0xd3c21bcecceda100ULL, 0x0000000000000000ULL, 0x84595161401484a0ULL, 0x0000000000000000ULL,
+            0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL, 0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+            0x813f3978f8940984ULL, 0x4000000000000000ULL, 0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+            0xc9f2c9cd04674edeULL, 0xa400000000000000ULL, 0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+            0x9dc5ada82b70b59dULL, 0xf020000000000000ULL, 0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+            0xf684df56c3e01bc6ULL, 0xc732000000000000ULL, 0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+            0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL, 0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+            0x96769950b50d88f4ULL, 0x1314448000000000ULL, 0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+            0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL, 0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+            0xb7abc627050305adULL, 0xf14a3d9e40000000ULL, 0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+            0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL, 0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+            0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL, 0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+            0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL, 0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+            0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL, 0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+            0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL, 0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+            0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL, 0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+            0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL, 0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+            0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL, 0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+            0x9f4f2726179a2245ULL, 0x01d762422c946590ULL, 0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+            0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL, 0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+            0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL, 0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+            0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL, 0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+            0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL, 0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+            0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL, 0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+            0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL, 0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+            0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL, 0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+            0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL, 0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+            0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL, 0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+            0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL, 0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+            0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL, 0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+            0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL, 0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+            0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL, 0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+            0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL, 0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+            0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL, 0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+            0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL, 0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+            0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL, 0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+            0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL, 0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+            0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL, 0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+            0x924d692ca61be758ULL, 0x593c2626705f9c56ULL, 0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+            0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL, 0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+            0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL, 0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+            0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL, 0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+            0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL, 0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+            0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL, 0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+            0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL, 0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+            0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL, 0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+            0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL, 0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+            0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL, 0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+            0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL, 0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+            0x9ae757596946075fULL, 0x3375788de9b06958ULL, 0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+            0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL, 0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+            0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL, 0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+            0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL, 0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+            0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL, 0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+            0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL, 0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+            0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL, 0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+            0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL, 0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+            0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL, 0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+            0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL, 0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+            0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL, 0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+            0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL, 0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+            0x802221226be55a64ULL, 0xc2494954da2c9789ULL, 0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+            0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL, 0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+            0x9c69a97284b578d7ULL, 0xff2a760414536efbULL, 0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+            0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL, 0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+            0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL, 0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+            0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL, 0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+            0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL, 0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+            0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL, 0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+            0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL, 0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+            0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL, 0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+            0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL, 0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+            0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL, 0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+            0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL, 0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+            0xa59bc234db398c25ULL, 0x43fab9837e699095ULL, 0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+            0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL, 0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+            0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL, 0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+            0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL, 0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+            0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL, 0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+            0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL, 0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+            0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL, 0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+            0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL, 0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+            0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL, 0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+            0x8fa475791a569d10ULL, 0xf96e017d694487bcULL, 0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+            0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL, 0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+            0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL, 0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+            0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL, 0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+            0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL, 0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+            0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL, 0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+            0x82a45b450226b39cULL, 0xecc0024661173473ULL, 0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+            0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL, 0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+            0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL, 0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+            0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL, 0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+            0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL, 0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+            0x98165af37b2153deULL, 0xc3727a337a8b704aULL, 0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+            0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL, 0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+            0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL, 0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+            0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL, 0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+            0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL, 0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+            0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL, 0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+            0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL, 0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+            0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL, 0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+            0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL, 0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+            0x83ea2b892091e44dULL, 0x934aed0aab460432ULL, 0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+            0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL, 0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+            0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL, 0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+            0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL, 0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+            0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL, 0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+            0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL, 0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+            0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL, 0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+            0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL, 0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+            0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL, 0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+            0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL, 0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+            0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL, 0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+            0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL, 0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+            0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL, 0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+            0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL, 0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+            0x8533285c936b35deULL, 0xd53a88958f87275fULL, 0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+            0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL, 0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+            0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL, 0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+            0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL, 0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+            0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL, 0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+            0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL, 0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+            0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL, 0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+            0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL, 0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+            0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL, 0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+            0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL, 0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+            0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL, 0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+            0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL, 0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+            0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL, 0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+            0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL, 0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+            0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL, 0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+            0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL, 0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+            0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL, 0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+            0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL, 0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+            0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL, 0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+            0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL, 0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+            0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL, 0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+            0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL, 0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+            0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL, 0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+            0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL, 0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+            0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL, 0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+            0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL
+        };
+        return table;
+    }
+};
+
+// JsonFormatW writes number as ascii text without locale. Integer is written
+// two digits at a time. Double is written in the shortest digits that parse
+// back to the same double by Ryu algorithm, with 128-bit tables of powers of
+// five. Output is fixed notation for decimal exponent in [-6, 20] and
+// scientific notation otherwise, integral double keeps ".0" so it is parsed
+// back as FLOAT.
+class JsonFormatW
+{
+public:
+    // buffer size that any number fits in
+    const static size_t BUFFER_SIZE = 32;
+
+    // write integer into buffer, return the length
+    static size_t integer(long long value, char* buffer)
+    {
+        if (value < 0)
+        {
+            *buffer = '-';
+            return 1 + integer(0 - (unsigned long long)value, buffer + 1);
+        }
+
+        return integer((unsigned long long)value, buffer);
+    }
+
+    static size_t integer(unsigned long long value, char* buffer)
+    {
+        char digits[24];
+        char* cur = digits + sizeof(digits);
+        uint64_t magnitude = value;
+
+        while (magnitude >= 100)
+        {
+            cur -= 2;
+            std::memcpy(cur, pairs() + (magnitude % 100) * 2, 2);
+            magnitude /= 100;
+        }
+
+        if (magnitude >= 10)
+        {
+            cur -= 2;
+            std::memcpy(cur, pairs() + magnitude * 2, 2);
+        }
+        else
+        {
+            *(--cur) = (char)('0' + magnitude);
+        }
+
+        size_t length = (size_t)(digits + sizeof(digits) - cur);
+        std::memcpy(buffer, cur, length);
+        return length;
+    }
+
+    // write long double into buffer, return the length. Value in double
+    // range is written as double, value beyond it, which is read by strtold,
+    // is written in the fewest digits that strtold reads back the same.
+    static size_t frac(long double value, char* buffer)
+    {
+        double narrow = (double)value;
+        if (std::isfinite(narrow) || !std::isfinite(value))
+        {
+            return frac(narrow, buffer);
+        }
+
+        char text[2 * BUFFER_SIZE];
+        for (int precision = 0; precision < std::numeric_limits<long double>::max_digits10; precision++)
+        {
+            std::snprintf(text, sizeof(text), "%.*Le", precision, value);
+            if (std::strtold(text, nullptr) == value)
+            {
+                break;
+            }
+        }
+
+        const char* cur = text;
+        char* out = buffer;
+
+        if (*cur == '-')
+        {
+            *out++ = *cur++;
+        }
+        *out++ = *cur++;
+
+        // radix character of the locale becomes '.', trailing zeros of the
+        // fraction are dropped
+        while (*cur != 'e' && (*cur < '0' || *cur > '9'))
+        {
+            cur++;
+        }
+
+        char* dot = out;
+        *out++ = '.';
+        while (*cur >= '0' && *cur <= '9')
+        {
+            *out++ = *cur++;
+        }
+
+        while (out[-1] == '0')
+        {
+            out--;
+        }
+        if (out - 1 == dot)
+        {
+            out--;
+        }
+
+        *out++ = 'e';
+        out += integer((long long)std::atoi(cur + 1), out);
+        return (size_t)(out - buffer);
+    }
+
+    // write double into buffer, return the length. Infinity and NaN have no
+    // json form and are written as null.
+    static size_t frac(double value, char* buffer)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        uint64_t mantissa = bits & ((1ULL << 52) - 1);
+        uint32_t exponent = (uint32_t)((bits >> 52) & 0x7FF);
+        char* cur = buffer;
+
+        if (exponent == 0x7FF)
+        {
+            std::memcpy(buffer, "null", 4);
+            return 4;
+        }
+
+        if ((bits >> 63) != 0)
+        {
+            *cur++ = '-';
+        }
+
+        if (exponent == 0 && mantissa == 0)
+        {
+            std::memcpy(cur, "0.0", 3);
+            return (size_t)(cur - buffer) + 3;
+        }
+
+        int32_t scale;
+        uint64_t output = shortest(mantissa, exponent, scale);
+
+        // output has 'length' digits, the value is output * 10^scale
+        char digits[24];
+        size_t length = integer((long long)output, digits);
+        int32_t point = (int32_t)length + scale;
+
+        if (point > 21 || point < -5)
+        {
+            // d.ddde-x
+            *cur++ = digits[0];
+            if (length > 1)
+            {
+                *cur++ = '.';
+                std::memcpy(cur, digits + 1, length - 1);
+                cur += length - 1;
+            }
+            *cur++ = 'e';
+            cur += integer((long long)(point - 1), cur);
+        }
+        else if (scale >= 0)
+        {
+            // ddd000.0
+            std::memcpy(cur, digits, length);
+            cur += length;
+            std::memset(cur, '0', (size_t)scale);
+            cur += scale;
+            std::memcpy(cur, ".0", 2);
+            cur += 2;
+        }
+        else if (point > 0)
+        {
+            // ddd.ddd
+            std::memcpy(cur, digits, (size_t)point);
+            cur += point;
+            *cur++ = '.';
+            std::memcpy(cur, digits + point, length - (size_t)point);
+            cur += length - (size_t)point;
+        }
+        else
+        {
+            // 0.000ddd
+            *cur++ = '0';
+            *cur++ = '.';
+            std::memset(cur, '0', (size_t)-point);
+            cur += -point;
+            std::memcpy(cur, digits, length);
+            cur += length;
+        }
+
+        return (size_t)(cur - buffer);
+    }
+
+private:
+    // "00" to "99"
+    static const char* pairs()
+    {
+        static const char table[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        return table;
+    }
+
+    // shortest decimal digits of non-zero finite double, return the digits
+    // and the decimal exponent in scale
+    static uint64_t shortest(uint64_t mantissa, uint32_t exponent, int32_t& scale)
+    {
+        int32_t e2;
+        uint64_t m2;
+
+        if (exponent == 0)
+        {
+            e2 = 1 - 1023 - 52 - 2;
+            m2 = mantissa;
+        }
+        else
+        {
+            e2 = (int32_t)exponent - 1023 - 52 - 2;
+            m2 = (1ULL << 52) | mantissa;
+        }
+
+        // the interval of valid representations is [mm, mp] in 4 * m2 * 2^e2,
+        // boundaries are included if m2 is even
+        const bool even = (m2 & 1) == 0;
+        const uint64_t mv = 4 * m2;
+        const uint32_t mmshift = (mantissa != 0 || exponent <= 1) ? 1 : 0;
+
+        uint64_t vr, vp, vm;
+        int32_t e10;
+        bool vmzeros = false;
+        bool vrzeros = false;
+
+        if (e2 >= 0)
+        {
+            const uint32_t q = log10pow2(e2) - (e2 > 3 ? 1 : 0);
+            const int32_t k = 125 + pow5bits((int32_t)q) - 1;
+            const int32_t i = -e2 + (int32_t)q + k;
+            const uint64_t* mul = inverses() + q * 2;
+
+            e10 = (int32_t)q;
+            vr = mulshift(4 * m2, mul, i);
+            vp = mulshift(4 * m2 + 2, mul, i);
+            vm = mulshift(4 * m2 - 1 - mmshift, mul, i);
+
+            if (q <= 21)
+            {
+                // only one of mp, mv and mm can be a multiple of 5
+                if (mv % 5 == 0)
+                {
+                    vrzeros = pow5factor(mv) >= q;
+                }
+                else if (even)
+                {
+                    vmzeros = pow5factor(mv - 1 - mmshift) >= q;
+                }
+                else
+                {
+                    vp -= pow5factor(mv + 2) >= q ? 1 : 0;
+                }
+            }
+        }
+        else
+        {
+            const uint32_t q = log10pow5(-e2) - (-e2 > 1 ? 1 : 0);
+            const int32_t i = -e2 - (int32_t)q;
+            const int32_t k = pow5bits(i) - 125;
+            const int32_t j = (int32_t)q - k;
+            const uint64_t* mul = fives() + i * 2;
+
+            e10 = (int32_t)q + e2;
+            vr = mulshift(4 * m2, mul, j);
+            vp = mulshift(4 * m2 + 2, mul, j);
+            vm = mulshift(4 * m2 - 1 - mmshift, mul, j);
+
+            if (q <= 1)
+            {
+                // mv = 4 * m2 always has at least two trailing zero bits
+                vrzeros = true;
+                if (even)
+                {
+                    vmzeros = mmshift == 1;
+                }
+                else
+                {
+                    --vp;
+                }
+            }
+            else if (q < 63)
+            {
+                vrzeros = (mv & ((1ULL << q) - 1)) == 0;
+            }
+        }
+
+        // remove digits while vp and vm still differ
+        int32_t removed = 0;
+        uint32_t lastdigit = 0;
+        uint64_t output;
+
+        if (vmzeros || vrzeros)
+        {
+            // rare case that needs to track the trailing zeros
+            while (vp / 10 > vm / 10)
+            {
+                vmzeros = vmzeros && vm % 10 == 0;
+                vrzeros = vrzeros && lastdigit == 0;
+                lastdigit = (uint32_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+
+            if (vmzeros)
+            {
+                while (vm % 10 == 0)
+                {
+                    vrzeros = vrzeros && lastdigit == 0;
+                    lastdigit = (uint32_t)(vr % 10);
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                    removed++;
+                }
+            }
+
+            if (vrzeros && lastdigit == 5 && vr % 2 == 0)
+            {
+                // exactly half way, round to even
+                lastdigit = 4;
+            }
+
+            output = vr + (((vr == vm && (!even || !vmzeros)) || lastdigit >= 5) ? 1 : 0);
+        }
+        else
+        {
+            bool roundup = false;
+
+            if (vp / 100 > vm / 100)
+            {
+                roundup = vr % 100 >= 50;
+                vr /= 100;
+                vp /= 100;
+                vm /= 100;
+                removed += 2;
+            }
+
+            while (vp / 10 > vm / 10)
+            {
+                roundup = vr % 10 >= 5;
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+
+            output = vr + ((vr == vm || roundup) ? 1 : 0);
+        }
+
+        scale = e10 + removed;
+        return output;
+    }
+
+    // (m * mul) >> j, mul is 128 bits and 115 <= j < 128
+    static uint64_t mulshift(uint64_t m, const uint64_t* mul, int32_t j)
+    {
+        uint64_t high0, low0, high1, low1;
+        JsonFloatW::multiply(m, mul[0], high0, low0);
+        JsonFloatW::multiply(m, mul[1], high1, low1);
+
+        uint64_t low = low1 + high0;
+        uint64_t high = high1 + (low < high0 ? 1 : 0);
+        int32_t shift = j - 64;
+        return (high << (64 - shift)) | (low >> shift);
+    }
+
+    // number of times value is divisible by 5
+    static uint32_t pow5factor(uint64_t value)
+    {
+        uint32_t count = 0;
+        while (value % 5 == 0)
+        {
+            value /= 5;
+            count++;
+        }
+        return count;
+    }
+
+    // bits of 5^e, ceil(log2(5^e)) for e > 0
+    static int32_t pow5bits(int32_t e)
+    {
+        return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+    }
+
+    // floor(log10(2^e))
+    static uint32_t log10pow2(int32_t e)
+    {
+        return ((uint32_t)e * 78913) >> 18;
+    }
+
+    // floor(log10(5^e))
+    static uint32_t log10pow5(int32_t e)
+    {
+        return ((uint32_t)e * 732923) >> 20;
+    }
+
+    // 2^(bits(5^q) - 1 + 125) / 5^q + 1 for 0 <= q < 342, low word first
+    static const uint64_t* inverses()
+    {
+        static const uint64_t table[] =
+        {
+            0x0000000000000001ULL, 0x2000000000000000ULL, 0x999999999999999aULL, 0x1999999999999999ULL,
+            0x47ae147ae147ae15ULL, 0x147ae147ae147ae1ULL, 0x6c8b4395810624deULL, 0x10624dd2f1a9fbe7ULL,
+            0x7a786c226809d496ULL, 0x1a36e2eb1c432ca5ULL, 0x61f9f01b866e43abULL, 0x14f8b588e368f084ULL,
+            0xb4c7f34938583622ULL, 0x10c6f7a0b5ed8d36ULL, 0x87a6520ec08d236aULL, 0x1ad7f29abcaf4857ULL,
+            0x9fb841a566d74f88ULL, 0x15798ee2308c39dfULL, 0xe62d01511f12a607ULL, 0x112e0be826d694b2ULL,
+            0xd6ae6881cb5109a4ULL, 0x1b7cdfd9d7bdbab7ULL, 0xdef1ed34a2a73aeaULL, 0x15fd7fe17964955fULL,
+            0x7f27f0f6e885c8bbULL, 0x119799812dea1119ULL, 0x650cb4be40d60df8ULL, 0x1c25c268497681c2ULL,
+            0xea70909833de7193ULL, 0x16849b86a12b9b01ULL, 0x21f3a6e0297ec143ULL, 0x1203af9ee756159bULL,
+            0x6985d7cd0f313537ULL, 0x1cd2b297d889bc2bULL, 0x2137dfd73f5a90f9ULL, 0x170ef54646d49689ULL,
+            0xe75fe645cc4873faULL, 0x12725dd1d243aba0ULL, 0xa5663d3c7a0d865dULL, 0x1d83c94fb6d2ac34ULL,
+            0x511e976394d79eb1ULL, 0x179ca10c9242235dULL, 0xda7edf82dd794bc1ULL, 0x12e3b40a0e9b4f7dULL,
+            0x2a6498d1625bac68ULL, 0x1e392010175ee596ULL, 0xeeb6e0a781e2f053ULL, 0x182db34012b25144ULL,
+            0x58924d52ce4f26a9ULL, 0x1357c299a88ea76aULL, 0x27507bb7b07ea441ULL, 0x1ef2d0f5da7dd8aaULL,
+            0x52a6c95fc0655034ULL, 0x18c240c4aecb13bbULL, 0x0eebd44c99eaa690ULL, 0x13ce9a36f23c0fc9ULL,
+            0xb17953adc3110a80ULL, 0x1fb0f6be50601941ULL, 0xc12ddc8b02740867ULL, 0x195a5efea6b34767ULL,
+            0x3424b06f3529a052ULL, 0x14484bfeebc29f86ULL, 0x901d59f290ee19dbULL, 0x1039d66589687f9eULL,
+            0x4cfbc31db4b0295fULL, 0x19f623d5a8a73297ULL, 0x3d9635b15d59bab2ULL, 0x14c4e977ba1f5bacULL,
+            0x97ab5e277de16228ULL, 0x109d8792fb4c4956ULL, 0xf2abc9d8c9689d0dULL, 0x1a95a5b7f87a0ef0ULL,
+            0x5bbca17a3aba173eULL, 0x154484932d2e725aULL, 0xafca1ac82efb45cbULL, 0x11039d428a8b8eaeULL,
+            0xb2dcf7a6b1920945ULL, 0x1b38fb9daa78e44aULL, 0xf57d92ebc141a104ULL, 0x15c72fb1552d836eULL,
+            0xc46475896767b403ULL, 0x116c262777579c58ULL, 0x6d6d88dbd8a5ecd2ULL, 0x1be03d0bf225c6f4ULL,
+            0x8abe071646eb23dbULL, 0x164cfda3281e38c3ULL, 0x6efe6c11d255b649ULL, 0x11d7314f534b609cULL,
+            0xb197134fb6ef8a0eULL, 0x1c8b821885456760ULL, 0x27ac0f72f8bfa1a5ULL, 0x16d601ad376ab91aULL,
+            0xb95672c260994e1eULL, 0x1244ce242c5560e1ULL, 0xf5571e03cdc21695ULL, 0x1d3ae36d13bbce35ULL,
+            0x2aac18030b01ababULL, 0x17624f8a762fd82bULL, 0xbbbce0026f348956ULL, 0x12b50c6ec4f31355ULL,
+            0x92c7ccd0b1eda889ULL, 0x1dee7a4ad4b81eefULL, 0xdbd30a408e57ba07ULL, 0x17f1fb6f10934bf2ULL,
+            0x7ca8d50071dfc806ULL, 0x1327fc58da0f6ff5ULL, 0xfaa7bb33e9660cd6ULL, 0x1ea6608e29b24cbbULL,
+            0x9552fc298784d711ULL, 0x18851a0b548ea3c9ULL, 0xaaa8c9bad2d0ac0eULL, 0x139dae6f76d88307ULL,
+            0xdddadc5e1e1aace3ULL, 0x1f62b0b257c0d1a5ULL, 0x7e48b04b4b488a4fULL, 0x191bc08eac9a4151ULL,
+            0xcb6d59d5d5d3a1d9ULL, 0x141633a556e1cddaULL, 0x3c577b1177dc817bULL, 0x1011c2eaabe7d7e2ULL,
+            0xc6f25e825960cf2aULL, 0x19b604aaaca62636ULL, 0x6bf518684780a5bbULL, 0x14919d5556eb51c5ULL,
+            0x232a79ed06008496ULL, 0x10747ddddf22a7d1ULL, 0xd1dd8fe1a3340756ULL, 0x1a53fc9631d10c81ULL,
+            0xa7e4731ae8f66c45ULL, 0x150ffd44f4a73d34ULL, 0x531d28e253f8569eULL, 0x10d9976a5d52975dULL,
+            0xeb61db03b98d5762ULL, 0x1af5bf109550f22eULL, 0xbc4e48cfc7a445e8ULL, 0x159165a6ddda5b58ULL,
+            0x6371d3d96c836b20ULL, 0x11411e1f17e1e2adULL, 0x9f1c8628ad9f11cdULL, 0x1b9b6364f3030448ULL,
+            0xe5b06b53be18db0bULL, 0x1615e91d8f359d06ULL, 0xeaf3890fcb4715a2ULL, 0x11ab20e472914a6bULL,
+            0x44b8db4c7871bc37ULL, 0x1c45016d841baa46ULL, 0x03c715d6c6c1635fULL, 0x169d9abe03495505ULL,
+            0x3638de456bcde919ULL, 0x1217aefe69077737ULL, 0x56c163a2461641c1ULL, 0x1cf2b1970e725858ULL,
+            0xdf011c81d1ab67ceULL, 0x17288e1271f51379ULL, 0x7f3416ce4155eca5ULL, 0x1286d80ec190dc61ULL,
+            0x6520247d3556476eULL, 0x1da48ce468e7c702ULL, 0xea801d30f7783925ULL, 0x17b6d71d20b96c01ULL,
+            0xbb99b0f3f92cfa84ULL, 0x12f8ac174d612334ULL, 0x5f5c4e532847f739ULL, 0x1e5aacf215683854ULL,
+            0x7f7d0b75b9d32c2eULL, 0x18488a5b44536043ULL, 0x9930d5f7c7dc2358ULL, 0x136d3b7c36a919cfULL,
+            0x8eb4898c72f9d226ULL, 0x1f152bf9f10e8fb2ULL, 0x722a07a38f2e41b8ULL, 0x18ddbcc7f40ba628ULL,
+            0xc1bb394fa5be9afaULL, 0x13e497065cd61e86ULL, 0x9c5ec2190930f7f6ULL, 0x1fd424d6faf030d7ULL,
+            0x49e56814075a5ff8ULL, 0x197683df2f268d79ULL, 0x6e51201005e1e660ULL, 0x145ecfe5bf520ac7ULL,
+            0xf1da800cd181851aULL, 0x104bd984990e6f05ULL, 0x4fc400148268d4f5ULL, 0x1a12f5a0f4e3e4d6ULL,
+            0xd96999aa01ed772bULL, 0x14dbf7b3f71cb711ULL, 0xadee1488018ac5bcULL, 0x10aff95cc5b09274ULL,
+            0x497ceda668de092cULL, 0x1ab328946f80ea54ULL, 0x3aca57b853e4d424ULL, 0x155c2076bf9a5510ULL,
+            0x623b7960431d7683ULL, 0x1116805effaeaa73ULL, 0x9d2bf566d1c8bd9eULL, 0x1b5733cb32b110b8ULL,
+            0x7dbcc452416d647fULL, 0x15df5ca28ef40d60ULL, 0xcafd69db678ab6ccULL, 0x117f7d4ed8c33de6ULL,
+            0xab2f0fc572778adfULL, 0x1bff2ee48e052fd7ULL, 0x88f273045b92d580ULL, 0x1665bf1d3e6a8cacULL,
+            0xd3f528d049424466ULL, 0x11eaff4a98553d56ULL, 0xb988414d4203a0a3ULL, 0x1cab3210f3bb9557ULL,
+            0x6139cdd76802e6e9ULL, 0x16ef5b40c2fc7779ULL, 0xe761717920025254ULL, 0x125915cd68c9f92dULL,
+            0xa568b58e999d5086ULL, 0x1d5b561574765b7cULL, 0x5120913ee14aa6d2ULL, 0x177c44ddf6c515fdULL,
+            0xa74d40ff1aa21f0eULL, 0x12c9d0b1923744caULL, 0x0baece64f769cb4aULL, 0x1e0fb44f50586e11ULL,
+            0x3c8bd850c5ee3c3bULL, 0x180c903f7379f1a7ULL, 0xca0979da37f1c9c9ULL, 0x133d4032c2c7f485ULL,
+            0xa9a8c2f6bfe942dbULL, 0x1ec866b79e0cba6fULL, 0x2153cf2bccba9be3ULL, 0x18a0522c7e709526ULL,
+            0x1aa9728970954982ULL, 0x13b374f06526ddb8ULL, 0xf775840f1a88759dULL, 0x1f8587e7083e2f8cULL,
+            0x5f9136727ba05e17ULL, 0x19379fec0698260aULL, 0x1940f85b9619e4dfULL, 0x142c7ff0054684d5ULL,
+            0xe100c6afab47ea4cULL, 0x1023998cd1053710ULL, 0xce67a44c453fdd47ULL, 0x19d28f47b4d524e7ULL,
+            0xd852e9d69dccb106ULL, 0x14a8729fc3ddb71fULL, 0x79dbee454b0a2738ULL, 0x1086c219697e2c19ULL,
+            0x295fe3a211a9d859ULL, 0x1a71368f0f30468fULL, 0xbab31c81a7bb137aULL, 0x15275ed8d8f36ba5ULL,
+            0x6228e39aec95a92fULL, 0x10ec4be0ad8f8951ULL, 0x9d0e38f7e0ef7517ULL, 0x1b13ac9aaf4c0ee8ULL,
+            0xb0d82d931a592a79ULL, 0x15a956e225d67253ULL, 0x8d79be0f4847552eULL, 0x11544581b7dec1dcULL,
+            0x158f967eda0bbb7cULL, 0x1bba08cf8c979c94ULL, 0x77a611ff14d62f97ULL, 0x162e6d72d6dfb076ULL,
+            0xf951a7ff43de8c79ULL, 0x11bebdf578b2f391ULL, 0xc21c3ffed2fdad8eULL, 0x1c6463225ab7ec1cULL,
+            0x01b0333242648ad8ULL, 0x16b6b5b5155ff017ULL, 0x0159c28e9b83a246ULL, 0x122bc490dde659acULL,
+            0xcef604175f3903a3ULL, 0x1d12d41afca3c2acULL, 0x725e69ac4c2d9c83ULL, 0x17424348ca1c9bbdULL,
+            0xf5185489d68ae39cULL, 0x129b69070816e2fdULL, 0xee8d540fbdab05c6ULL, 0x1dc574d80cf16b2fULL,
+            0xbed77672fe226b05ULL, 0x17d12a4670c1228cULL, 0xff12c528cb4ebc04ULL, 0x130dbb6b8d674ed6ULL,
+            0xcb513b74787df9a0ULL, 0x1e7c5f127bd87e24ULL, 0x090dc929f9fe614dULL, 0x18637f41fcad31b7ULL,
+            0xa0d7d42194cb810aULL, 0x1382cc34ca2427c5ULL, 0x67bfb9cf5478ce77ULL, 0x1f37ad21436d0c6fULL,
+            0x1fcc94a5dd2d71f9ULL, 0x18f9574dcf8a7059ULL, 0x7fd6dd517dbdf4c7ULL, 0x13faac3e3fa1f37aULL,
+            0xffbe2ee8c92fee0bULL, 0x1ff779fd329cb8c3ULL, 0x6631bf20a0f324d6ULL, 0x1992c7fdc216fa36ULL,
+            0xb827cc1a1a5c1d78ULL, 0x14756ccb01abfb5eULL, 0x935309ae7b7ce460ULL, 0x105df0a267bcc918ULL,
+            0x1eeb42b0c594a099ULL, 0x1a2fe76a3f9474f4ULL, 0xe58902270476e6e1ULL, 0x14f31f8832dd2a5cULL,
+            0xb7a0ce859d2bebe7ULL, 0x10c27fa028b0eeb0ULL, 0x59014a6f61dfdfd8ULL, 0x1ad0cc33744e4ab4ULL,
+            0xe0cdd525e7e64cadULL, 0x1573d68f903ea229ULL, 0x4d7177518651d6f1ULL, 0x11297872d9cbb4eeULL,
+            0x7be8bee8d6e957e8ULL, 0x1b758d848fac54b0ULL, 0xfcba3253df211320ULL, 0x15f7a46a0c89dd59ULL,
+            0x63c8284318e74280ULL, 0x1192e9ee706e4aaeULL, 0x060d0d3827d86a66ULL, 0x1c1e43171a4a1117ULL,
+            0x6b3da42cecad21ebULL, 0x167e9c127b6e7412ULL, 0x88fe1cf0bd574e56ULL, 0x11fee341fc585cdbULL,
+            0x419694b462254a23ULL, 0x1ccb0536608d615fULL, 0x67abaa29e81dd4e9ULL, 0x1708d0f84d3de77fULL,
+            0xb95621bb2017dd87ULL, 0x126d73f9d764b932ULL, 0xc223692b668c95a5ULL, 0x1d7becc2f23ac1eaULL,
+            0xce82ba891ed6de1dULL, 0x179657025b6234bbULL, 0xa53562074bdf1818ULL, 0x12deac01e2b4f6fcULL,
+            0x3b889cd87964f359ULL, 0x1e3113363787f194ULL, 0xfc6d4a46c783f5e1ULL, 0x18274291c6065adcULL,
+            0x30576e9f06032b1aULL, 0x13529ba7d19eaf17ULL, 0x1a257dcb3cd1de90ULL, 0x1eea92a61c311825ULL,
+            0x481dfe3c30a7e540ULL, 0x18bba884e35a79b7ULL, 0xd34b31c9c0865100ULL, 0x13c9539d82aec7c5ULL,
+            0x5211e942cda3b4cdULL, 0x1fa885c8d117a609ULL, 0x74db21023e1c90a4ULL, 0x19539e3a40dfb807ULL,
+            0xf715b401cb4a0d50ULL, 0x1442e4fb67196005ULL, 0xf8de299b09080aa7ULL, 0x103583fc527ab337ULL,
+            0x8e304291a80cddd7ULL, 0x19ef3993b72ab859ULL, 0x3e8d020e200a4b13ULL, 0x14bf6142f8eef9e1ULL,
+            0x653d9b3e80083c0fULL, 0x10991a9bfa58c7e7ULL, 0x6ec8f864000d2ce4ULL, 0x1a8e90f9908e0ca5ULL,
+            0x8bd3f9e999a423eaULL, 0x153eda614071a3b7ULL, 0x3ca994bae1501cbbULL, 0x10ff151a99f482f9ULL,
+            0xc775bac49bb3612bULL, 0x1b31bb5dc320d18eULL, 0xd2c4956a16291a89ULL, 0x15c162b168e70e0bULL,
+            0xdbd0778811ba7ba1ULL, 0x11678227871f3e6fULL, 0x2c80bf401c5d929bULL, 0x1bd8d03f3e9863e6ULL,
+            0xbd33cc3349e47549ULL, 0x16470cff6546b651ULL, 0xca8fd68f6e505dd4ULL, 0x11d270cc51055ea7ULL,
+            0x4419574be3b3c953ULL, 0x1c83e7ad4e6efdd9ULL, 0x0347790982f63aa9ULL, 0x16cfec8aa52597e1ULL,
+            0xcf6c60d468c4fbbaULL, 0x123ff06eea847980ULL, 0xe57a34870e07f92aULL, 0x1d331a4b10d3f59aULL,
+            0x512e906c0b399422ULL, 0x175c1508da432ae2ULL, 0xda8ba6bcd5c7a9b5ULL, 0x12b010d3e1cf5581ULL,
+            0x90df712e22d90f87ULL, 0x1de6815302e5559cULL, 0xda4c5a8b4f140c6cULL, 0x17eb9aa8cf1dde16ULL,
+            0xaea37ba2a5a9a38aULL, 0x1322e220a5b17e78ULL, 0x7dd25f6aa2a905a9ULL, 0x1e9e369aa2b59727ULL,
+            0x97db7f888220d154ULL, 0x187e92154ef7ac1fULL, 0x797c6606ce80a777ULL, 0x139874ddd8c6234cULL,
+            0x8f2d700ae4010bf1ULL, 0x1f5a549627a36badULL, 0x0c2459a25000d65aULL, 0x191510781fb5efbeULL,
+            0x701d1481d99a4515ULL, 0x1410d9f9b2f7f2feULL, 0xc017439b147b6a77ULL, 0x100d7b2e28c65bfeULL,
+            0xccf205c4ed9243f2ULL, 0x19af2b7d0e0a2ccaULL, 0x0a5b37d0be0e9cc2ULL, 0x148c22ca71a1bd6fULL,
+            0x0848f973cb3ee3ceULL, 0x10701bd527b4978cULL, 0xda0e5bec78649fb0ULL, 0x1a4cf9550c5425acULL,
+            0x7b3eaff060507fc0ULL, 0x150a6110d6a9b7bdULL, 0x95cbbff380406633ULL, 0x10d51a73deee2c97ULL,
+            0xefac665266cd7052ULL, 0x1aee90b964b04758ULL, 0x2623850eb8a459dbULL, 0x158ba6fab6f36c47ULL,
+            0x1e82d0d893b6ae49ULL, 0x113c85955f29236cULL, 0xfd9e1af41f8ab075ULL, 0x1b9408eefea838acULL,
+            0x97b1af29b2d559f7ULL, 0x16100725988693bdULL, 0xac8e25baf5777b2cULL, 0x11a66c1e139edc97ULL,
+            0x7a7d092b2258c513ULL, 0x1c3d79c9b8fe2dbfULL, 0x61fda0ef4ead6a76ULL, 0x169794a160cb57ccULL,
+            0xe7fe1a590bbdeec5ULL, 0x1212dd4de7091309ULL, 0xa6635d5b45fcb13aULL, 0x1ceafbafd80e84dcULL,
+            0x851c4aaf6b308dc8ULL, 0x172262f3133ed0b0ULL, 0xd0e36ef2bc26d7d4ULL, 0x1281e8c275cbda26ULL,
+            0xb49f17eac6a48c86ULL, 0x1d9ca79d894629d7ULL, 0x2a18dfef0550706bULL, 0x17b08617a104ee46ULL,
+            0x54e0b3259dd9f389ULL, 0x12f39e794d9d8b6bULL, 0x87cdeb6f62f65274ULL, 0x1e5297287c2f4578ULL,
+            0xd30b22bf825ea85dULL, 0x18421286c9bf6ac6ULL, 0x0f3c1bcc684bb9e4ULL, 0x13680ed23aff889fULL,
+            0x18602c7a4079296dULL, 0x1f0ce4839198da98ULL, 0x46b356c833942124ULL, 0x18d71d360e13e213ULL,
+            0x388f78a029434db6ULL, 0x13df4a91a4dcb4dcULL, 0x5a7f2766a86baf8aULL, 0x1fcbaa82a1612160ULL,
+            0x153285ebb9efbfa2ULL, 0x196fbb9bb44db44dULL, 0xaa8ed189618c994eULL, 0x145962e2f6a4903dULL,
+            0xeed8a7a11ad6e10cULL, 0x1047824f2bb6d9caULL, 0x7e27729b5e249b45ULL, 0x1a0c03b1df8af611ULL,
+            0xfe85f549181d4904ULL, 0x14d6695b193bf80dULL, 0xcb9e5dd4134aa0d0ULL, 0x10ab877c142ff9a4ULL,
+            0xdf63c9535211014dULL, 0x1aac0bf9b9e65c3aULL, 0x191ca10f74da6771ULL, 0x15566ffafb1eb02fULL,
+            0xadb080d92a4852c1ULL, 0x1111f32f2f4bc025ULL, 0x15e7348eaa0d5134ULL, 0x1b4feb7eb212cd09ULL,
+            0xab1f5d3eee710dc4ULL, 0x15d98932280f0a6dULL, 0xbc1917658b8da49dULL, 0x117ad428200c0857ULL,
+            0x2cf4f23c127c3a94ULL, 0x1bf7b9d9cce00d59ULL, 0xf0c3f4fcdb969543ULL, 0x165fc7e170b33de0ULL,
+            0x5a365d9716121103ULL, 0x11e6398126f5cb1aULL, 0x9056fc24f01ce804ULL, 0x1ca38f350b22de90ULL,
+            0xd9df301d8ce3ecd0ULL, 0x16e93f5da2824ba6ULL, 0xe17f59b13d8323daULL, 0x125432b14ecea2ebULL,
+            0x68cbc2b52f38395cULL, 0x1d53844ee47dd179ULL, 0x53d6355dbf602de3ULL, 0x177603725064a794ULL,
+            0xa9782ab165e68b1cULL, 0x12c4cf8ea6b6ec76ULL, 0x0f26aab56fd744faULL, 0x1e07b27dd78b13f1ULL,
+            0x3f52222abfdf6a62ULL, 0x18062864ac6f4327ULL, 0x65db4e88997f884eULL, 0x1338205089f29c1fULL,
+            0x6fc54a7428cc0d4aULL, 0x1ec033b40fea9365ULL, 0x596aa1f68709a43bULL, 0x1899c2f673220f84ULL,
+            0xadeee7f86c07b696ULL, 0x13ae3591f5b4d936ULL, 0x497e3ff3e00c5756ULL, 0x1f7d228322baf524ULL,
+            0xd464fff64cd6ac45ULL, 0x1930e868e89590e9ULL, 0x4383fff83d7889d1ULL, 0x14272053ed4473eeULL,
+            0xcf9cccc69793a174ULL, 0x101f4d0ff1038ff1ULL, 0x7f6147a425b90252ULL, 0x19cbae7fe805b31cULL,
+            0xcc4dd2e9b7c7350fULL, 0x14a2f1ffecd15c16ULL, 0x3d0b0f215fd290d9ULL, 0x10825b3323dab012ULL,
+            0x61ab4b689950e7c1ULL, 0x1a6a2b85062ab350ULL, 0x4e22a2ba1440b967ULL, 0x1521bc6a6b555c40ULL,
+            0x0b4ee894dd009453ULL, 0x10e7c9eebc4449cdULL, 0x1217da87c800ed51ULL, 0x1b0c764ac6d3a948ULL,
+            0xdb46486ca000bddaULL, 0x15a391d56bdc876cULL, 0x490506bd4ccd64afULL, 0x114fa7ddefe39f8aULL,
+            0xa8080ac87ae23ab1ULL, 0x1bb2a62fe638ff43ULL, 0x5339a239fbe82ef4ULL, 0x162884f31e93ff69ULL,
+            0x75c7b4fb2fecf25dULL, 0x11ba03f5b20fff87ULL, 0x22d92191e647ea2eULL, 0x1c5cd322b67fff3fULL,
+            0xb57a8141850654f2ULL, 0x16b0a8e891ffff65ULL, 0xc4620101373843f5ULL, 0x1226ed86db3332b7ULL,
+            0x3a366801f1f39feeULL, 0x1d0b15a491eb8459ULL, 0xfb5eb99b27f6198bULL, 0x173c115074bc69e0ULL,
+            0x2f7efae2865e7ad6ULL, 0x129674405d6387e7ULL, 0xe597f7d0d6fd9156ULL, 0x1dbd86cd6238d971ULL,
+            0x8479930d78cadaabULL, 0x17cad23de82d7ac1ULL, 0xd06142712d6f1556ULL, 0x1308a831868ac89aULL,
+            0x4d686a4eaf182222ULL, 0x1e74404f3daada91ULL, 0xa453883ef279b4e8ULL, 0x185d003f6488aedaULL,
+            0xe9dc6cff28615d87ULL, 0x137d99cc506d58aeULL, 0xa960ae650d6895a4ULL, 0x1f2f5c7a1a488de4ULL,
+            0xbab3beb73ded4483ULL, 0x18f2b061aea07183ULL, 0x2ef6322c318a9d36ULL, 0x13f559e7bee6c136ULL,
+            0xe4bd1d13827761f0ULL, 0x1feef63f97d79b89ULL, 0x83ca7da9352c4e5aULL, 0x198bf832dfdfafa1ULL,
+            0x9ca1fe20f756a515ULL, 0x146ff9c24cb2f2e7ULL, 0x4a1b31b3f9121daaULL, 0x1059949b708f28b9ULL,
+            0x435eb5ecc1b695ddULL, 0x1a28edc580e50df5ULL, 0x35e55e57015ede4aULL, 0x14ed8b04671da4c4ULL,
+            0xc4b77eac0118b1d5ULL, 0x10be08d0527e1d69ULL, 0xa12597799b5ab622ULL, 0x1ac9a7b3b7302f0fULL,
+            0x4db7ac6149155e81ULL, 0x156e1fc2f8f358d9ULL, 0xd7c6238107444b9bULL, 0x1124e63593f5e0adULL,
+            0x593d059b3ed3ac2bULL, 0x1b6e3d2286563449ULL, 0xe0fd9e15cbdc89bcULL, 0x15f1ca820511c36dULL,
+            0xb3fe18116fe3a163ULL, 0x118e3b9b37416924ULL, 0x866359b57fd29bd1ULL, 0x1c16c5c525357507ULL,
+            0xd1e91491330ee30eULL, 0x16789e3750f790d2ULL, 0x74ba76da8f3f1c0bULL, 0x11fa182c40c60d75ULL,
+            0xedf72490e531c678ULL, 0x1cc359e067a348bbULL, 0x8b2c1d40b75b052dULL, 0x1702ae4d1fb5d3c9ULL,
+            0x6f567dcd5f7c0424ULL, 0x12688b70e62b0fd4ULL, 0x7ef0c94898c66d06ULL, 0x1d74124e3d11b2edULL,
+            0x98c0a106e09ebd9fULL, 0x17900ea4fda7c257ULL, 0x470080d24d4bcae6ULL, 0x12d9a550caec9b79ULL,
+            0xd800ce1d487944a2ULL, 0x1e29088144adc58eULL, 0x1333d8176d2dd082ULL, 0x1820d39a9d57d13fULL,
+            0xa8f646792424a6ceULL, 0x134d76154aaca765ULL, 0x74bd3d8ea03aa47dULL, 0x1ee25688777aa56fULL,
+            0x5d64313ee6955064ULL, 0x18b51206c5fbb78cULL, 0x4ab68dcbebaaa6b7ULL, 0x13c40e6bd1962c70ULL,
+            0x1124161312aaa457ULL, 0x1fa01712e8f0471aULL, 0xda8344dc0eeee9dfULL, 0x194cdf4253f36c14ULL,
+            0xe2029d7cd8bf2180ULL, 0x143d7f6843292343ULL, 0x4e687dfd7a328133ULL, 0x103132b9cf541c36ULL,
+            0x4a40c9959050ceb8ULL, 0x19e851294bb9c6bdULL, 0x0833d477a6a70bc6ULL, 0x14b9da876fc7d231ULL,
+            0xa02976c61eec096bULL, 0x1094aed2bfd30e8dULL, 0x004257a364acdbdfULL, 0x1a877e1dffb81749ULL,
+            0xcd01dfb5ea23e319ULL, 0x153931b1996012a0ULL, 0x70ce4c91881cb5aeULL, 0x10fa8e27ade6754dULL,
+            0x1ae3adb5a69455e2ULL, 0x1b2a7d0c4970bbafULL, 0x7be957c4854377e8ULL, 0x15bb973d078d62f2ULL,
+            0xc987796a0435f987ULL, 0x1162df64060ab58eULL, 0x75a58f1006bcc271ULL, 0x1bd1656cd67788e4ULL,
+            0xf7b7a5a66bca3527ULL, 0x16411df0ab92d3e9ULL, 0x5fc61e1ebca1c41fULL, 0x11cdb18d560f0feeULL,
+            0xffa363646102d365ULL, 0x1c7c4f4889b1b316ULL, 0x32e91c504d9bdc51ULL, 0x16c9d906d48e28dfULL,
+            0x8f20e37371497d0eULL, 0x123b140576d820b2ULL, 0x7e9b0585820f2e7cULL, 0x1d2b533bf159cdeaULL,
+            0xcbaf379e01a5becaULL, 0x1755dc2ff447d7eeULL, 0x0958f94b348498a1ULL, 0x12ab168cc36cacbfULL
+        };
+        return table;
+    }
+
+    // 5^i normalized to 125 bits for 0 <= i < 326, low word first
+    static const uint64_t* fives()
+    {
+        static const uint64_t table[] =
+        {
+            0x0000000000000000ULL, 0x1000000000000000ULL, 0x0000000000000000ULL, 0x1400000000000000ULL,
+            0x0000000000000000ULL, 0x1900000000000000ULL, 0x0000000000000000ULL, 0x1f40000000000000ULL,
+            0x0000000000000000ULL, 0x1388000000000000ULL, 0x0000000000000000ULL, 0x186a000000000000ULL,
+            0x0000000000000000ULL, 0x1e84800000000000ULL, 0x0000000000000000ULL, 0x1312d00000000000ULL,
+            0x0000000000000000ULL, 0x17d7840000000000ULL, 0x0000000000000000ULL, 0x1dcd650000000000ULL,
+            0x0000000000000000ULL, 0x12a05f2000000000ULL, 0x0000000000000000ULL, 0x174876e800000000ULL,
+            0x0000000000000000ULL, 0x1d1a94a200000000ULL, 0x0000000000000000ULL, 0x12309ce540000000ULL,
+            0x0000000000000000ULL, 0x16bcc41e90000000ULL, 0x0000000000000000ULL, 0x1c6bf52634000000ULL,
+            0x0000000000000000ULL, 0x11c37937e0800000ULL, 0x0000000000000000ULL, 0x16345785d8a00000ULL,
+            0x0000000000000000ULL, 0x1bc16d674ec80000ULL, 0x0000000000000000ULL, 0x1158e460913d0000ULL,
+            0x0000000000000000ULL, 0x15af1d78b58c4000ULL, 0x0000000000000000ULL, 0x1b1ae4d6e2ef5000ULL,
+            0x0000000000000000ULL, 0x10f0cf064dd59200ULL, 0x0000000000000000ULL, 0x152d02c7e14af680ULL,
+            0x0000000000000000ULL, 0x1a784379d99db420ULL, 0x0000000000000000ULL, 0x108b2a2c28029094ULL,
+            0x0000000000000000ULL, 0x14adf4b7320334b9ULL, 0x4000000000000000ULL, 0x19d971e4fe8401e7ULL,
+            0x8800000000000000ULL, 0x1027e72f1f128130ULL, 0xaa00000000000000ULL, 0x1431e0fae6d7217cULL,
+            0xd480000000000000ULL, 0x193e5939a08ce9dbULL, 0xc9a0000000000000ULL, 0x1f8def8808b02452ULL,
+            0xbe04000000000000ULL, 0x13b8b5b5056e16b3ULL, 0xad85000000000000ULL, 0x18a6e32246c99c60ULL,
+            0xd8e6400000000000ULL, 0x1ed09bead87c0378ULL, 0x878fe80000000000ULL, 0x13426172c74d822bULL,
+            0x6973e20000000000ULL, 0x1812f9cf7920e2b6ULL, 0x03d0da8000000000ULL, 0x1e17b84357691b64ULL,
+            0x8262889000000000ULL, 0x12ced32a16a1b11eULL, 0x22fb2ab400000000ULL, 0x178287f49c4a1d66ULL,
+            0xabb9f56100000000ULL, 0x1d6329f1c35ca4bfULL, 0xcb54395ca0000000ULL, 0x125dfa371a19e6f7ULL,
+            0xbe2947b3c8000000ULL, 0x16f578c4e0a060b5ULL, 0x2db399a0ba000000ULL, 0x1cb2d6f618c878e3ULL,
+            0xfc90400474400000ULL, 0x11efc659cf7d4b8dULL, 0x7bb4500591500000ULL, 0x166bb7f0435c9e71ULL,
+            0xdaa16406f5a40000ULL, 0x1c06a5ec5433c60dULL, 0xa8a4de8459868000ULL, 0x118427b3b4a05bc8ULL,
+            0xd2ce16256fe82000ULL, 0x15e531a0a1c872baULL, 0x87819baecbe22800ULL, 0x1b5e7e08ca3a8f69ULL,
+            0xf4b1014d3f6d5900ULL, 0x111b0ec57e6499a1ULL, 0x71dd41a08f48af40ULL, 0x1561d276ddfdc00aULL,
+            0x0e549208b31adb10ULL, 0x1aba4714957d300dULL, 0x28f4db456ff0c8eaULL, 0x10b46c6cdd6e3e08ULL,
+            0x33321216cbecfb24ULL, 0x14e1878814c9cd8aULL, 0xbffe969c7ee839edULL, 0x1a19e96a19fc40ecULL,
+            0xf7ff1e21cf512434ULL, 0x105031e2503da893ULL, 0xf5fee5aa43256d41ULL, 0x14643e5ae44d12b8ULL,
+            0x337e9f14d3eec892ULL, 0x197d4df19d605767ULL, 0x005e46da08ea7ab6ULL, 0x1fdca16e04b86d41ULL,
+            0xa03aec4845928cb2ULL, 0x13e9e4e4c2f34448ULL, 0xc849a75a56f72fdeULL, 0x18e45e1df3b0155aULL,
+            0x7a5c1130ecb4fbd6ULL, 0x1f1d75a5709c1ab1ULL, 0xec798abe93f11d65ULL, 0x13726987666190aeULL,
+            0xa797ed6e38ed64bfULL, 0x184f03e93ff9f4daULL, 0x517de8c9c728bdefULL, 0x1e62c4e38ff87211ULL,
+            0xd2eeb17e1c7976b5ULL, 0x12fdbb0e39fb474aULL, 0x87aa5ddda397d462ULL, 0x17bd29d1c87a191dULL,
+            0xe994f5550c7dc97bULL, 0x1dac74463a989f64ULL, 0x11fd195527ce9dedULL, 0x128bc8abe49f639fULL,
+            0xd67c5faa71c24568ULL, 0x172ebad6ddc73c86ULL, 0x8c1b77950e32d6c2ULL, 0x1cfa698c95390ba8ULL,
+            0x57912abd28dfc639ULL, 0x121c81f7dd43a749ULL, 0xad75756c7317b7c8ULL, 0x16a3a275d494911bULL,
+            0x98d2d2c78fdda5baULL, 0x1c4c8b1349b9b562ULL, 0x9f83c3bcb9ea8794ULL, 0x11afd6ec0e14115dULL,
+            0x0764b4abe8652979ULL, 0x161bcca7119915b5ULL, 0x493de1d6e27e73d7ULL, 0x1ba2bfd0d5ff5b22ULL,
+            0x6dc6ad264d8f0866ULL, 0x1145b7e285bf98f5ULL, 0xc938586fe0f2ca80ULL, 0x159725db272f7f32ULL,
+            0x7b866e8bd92f7d20ULL, 0x1afcef51f0fb5effULL, 0xad34051767bdae34ULL, 0x10de1593369d1b5fULL,
+            0x9881065d41ad19c1ULL, 0x15159af804446237ULL, 0x7ea147f492186032ULL, 0x1a5b01b605557ac5ULL,
+            0x6f24ccf8db4f3c1fULL, 0x1078e111c3556cbbULL, 0x4aee003712230b27ULL, 0x14971956342ac7eaULL,
+            0xdda98044d6abcdf0ULL, 0x19bcdfabc13579e4ULL, 0x0a89f02b062b60b6ULL, 0x10160bcb58c16c2fULL,
+            0xcd2c6c35c7b638e4ULL, 0x141b8ebe2ef1c73aULL, 0x8077874339a3c71dULL, 0x1922726dbaae3909ULL,
+            0xe0956914080cb8e4ULL, 0x1f6b0f092959c74bULL, 0x6c5d61ac8507f38eULL, 0x13a2e965b9d81c8fULL,
+            0x4774ba17a649f072ULL, 0x188ba3bf284e23b3ULL, 0x1951e89d8fdc6c8fULL, 0x1eae8caef261aca0ULL,
+            0x0fd3316279e9c3d9ULL, 0x132d17ed577d0be4ULL, 0x13c7fdbb186434cfULL, 0x17f85de8ad5c4eddULL,
+            0x58b9fd29de7d4203ULL, 0x1df67562d8b36294ULL, 0xb7743e3a2b0e4942ULL, 0x12ba095dc7701d9cULL,
+            0xe5514dc8b5d1db92ULL, 0x17688bb5394c2503ULL, 0xdea5a13ae3465277ULL, 0x1d42aea2879f2e44ULL,
+            0x0b2784c4ce0bf38aULL, 0x1249ad2594c37cebULL, 0xcdf165f6018ef06dULL, 0x16dc186ef9f45c25ULL,
+            0x416dbf7381f2ac88ULL, 0x1c931e8ab871732fULL, 0x88e497a83137abd5ULL, 0x11dbf316b346e7fdULL,
+            0xeb1dbd923d8596caULL, 0x1652efdc6018a1fcULL, 0x25e52cf6cce6fc7dULL, 0x1be7abd3781eca7cULL,
+            0x97af3c1a40105dceULL, 0x1170cb642b133e8dULL, 0xfd9b0b20d0147542ULL, 0x15ccfe3d35d80e30ULL,
+            0x3d01cde904199292ULL, 0x1b403dcc834e11bdULL, 0x462120b1a28ffb9bULL, 0x1108269fd210cb16ULL,
+            0xd7a968de0b33fa82ULL, 0x154a3047c694fddbULL, 0xcd93c3158e00f923ULL, 0x1a9cbc59b83a3d52ULL,
+            0xc07c59ed78c09bb6ULL, 0x10a1f5b813246653ULL, 0xb09b7068d6f0c2a3ULL, 0x14ca732617ed7fe8ULL,
+            0xdcc24c830cacf34cULL, 0x19fd0fef9de8dfe2ULL, 0xc9f96fd1e7ec180fULL, 0x103e29f5c2b18bedULL,
+            0x3c77cbc661e71e13ULL, 0x144db473335deee9ULL, 0x8b95beb7fa60e598ULL, 0x1961219000356aa3ULL,
+            0x6e7b2e65f8f91efeULL, 0x1fb969f40042c54cULL, 0xc50cfcffbb9bb35fULL, 0x13d3e2388029bb4fULL,
+            0xb6503c3faa82a037ULL, 0x18c8dac6a0342a23ULL, 0xa3e44b4f95234844ULL, 0x1efb1178484134acULL,
+            0xe66eaf11bd360d2bULL, 0x135ceaeb2d28c0ebULL, 0xe00a5ad62c839075ULL, 0x183425a5f872f126ULL,
+            0x980cf18bb7a47493ULL, 0x1e412f0f768fad70ULL, 0x5f0816f752c6c8dcULL, 0x12e8bd69aa19cc66ULL,
+            0xf6ca1cb527787b13ULL, 0x17a2ecc414a03f7fULL, 0xf47ca3e2715699d7ULL, 0x1d8ba7f519c84f5fULL,
+            0xf8cde66d86d62026ULL, 0x127748f9301d319bULL, 0xf7016008e88ba830ULL, 0x17151b377c247e02ULL,
+            0xb4c1b80b22ae923cULL, 0x1cda62055b2d9d83ULL, 0x50f91306f5ad1b65ULL, 0x12087d4358fc8272ULL,
+            0xe53757c8b318623fULL, 0x168a9c942f3ba30eULL, 0x9e852dbadfde7acfULL, 0x1c2d43b93b0a8bd2ULL,
+            0xa3133c94cbeb0cc1ULL, 0x119c4a53c4e69763ULL, 0x8bd80bb9fee5cff1ULL, 0x16035ce8b6203d3cULL,
+            0xaece0ea87e9f43eeULL, 0x1b843422e3a84c8bULL, 0x4d40c9294f238a75ULL, 0x1132a095ce492fd7ULL,
+            0x2090fb73a2ec6d12ULL, 0x157f48bb41db7bcdULL, 0x68b53a508ba78856ULL, 0x1adf1aea12525ac0ULL,
+            0x417144725748b536ULL, 0x10cb70d24b7378b8ULL, 0x51cd958eed1ae283ULL, 0x14fe4d06de5056e6ULL,
+            0xe640faf2a8619b24ULL, 0x1a3de04895e46c9fULL, 0xefe89cd7a93d00f7ULL, 0x1066ac2d5daec3e3ULL,
+            0xebe2c40d938c4134ULL, 0x14805738b51a74dcULL, 0x26db7510f86f5181ULL, 0x19a06d06e2611214ULL,
+            0x9849292a9b4592f1ULL, 0x100444244d7cab4cULL, 0xbe5b73754216f7adULL, 0x1405552d60dbd61fULL,
+            0xadf25052929cb598ULL, 0x1906aa78b912cba7ULL, 0x996ee4673743e2ffULL, 0x1f485516e7577e91ULL,
+            0xffe54ec0828a6ddfULL, 0x138d352e5096af1aULL, 0xbfdea270a32d0957ULL, 0x18708279e4bc5ae1ULL,
+            0x2fd64b0ccbf84badULL, 0x1e8ca3185deb719aULL, 0x5de5eee7ff7b2f4cULL, 0x1317e5ef3ab32700ULL,
+            0x755f6aa1ff59fb1fULL, 0x17dddf6b095ff0c0ULL, 0x92b7454a7f3079e7ULL, 0x1dd55745cbb7ecf0ULL,
+            0x5bb28b4e8f7e4c30ULL, 0x12a5568b9f52f416ULL, 0xf29f2e22335ddf3cULL, 0x174eac2e8727b11bULL,
+            0xef46f9aac035570bULL, 0x1d22573a28f19d62ULL, 0xd58c5c0ab8215667ULL, 0x123576845997025dULL,
+            0x4aef730d6629ac01ULL, 0x16c2d4256ffcc2f5ULL, 0x9dab4fd0bfb41701ULL, 0x1c73892ecbfbf3b2ULL,
+            0xa28b11e277d08e60ULL, 0x11c835bd3f7d784fULL, 0x8b2dd65b15c4b1f9ULL, 0x163a432c8f5cd663ULL,
+            0x6df94bf1db35de77ULL, 0x1bc8d3f7b3340bfcULL, 0xc4bbcf772901ab0aULL, 0x115d847ad000877dULL,
+            0x35eac354f34215cdULL, 0x15b4e5998400a95dULL, 0x8365742a30129b40ULL, 0x1b221effe500d3b4ULL,
+            0xd21f689a5e0ba108ULL, 0x10f5535fef208450ULL, 0x06a742c0f58e894aULL, 0x1532a837eae8a565ULL,
+            0x4851137132f22b9dULL, 0x1a7f5245e5a2cebeULL, 0xed32ac26bfd75b42ULL, 0x108f936baf85c136ULL,
+            0xa87f57306fcd3212ULL, 0x14b378469b673184ULL, 0xd29f2cfc8bc07e97ULL, 0x19e056584240fde5ULL,
+            0xa3a37c1dd7584f1eULL, 0x102c35f729689eafULL, 0x8c8c5b254d2e62e6ULL, 0x14374374f3c2c65bULL,
+            0x6faf71eea079fb9fULL, 0x1945145230b377f2ULL, 0x0b9b4e6a48987a87ULL, 0x1f965966bce055efULL,
+            0x674111026d5f4c94ULL, 0x13bdf7e0360c35b5ULL, 0xc111554308b71fbaULL, 0x18ad75d8438f4322ULL,
+            0x7155aa93cae4e7a8ULL, 0x1ed8d34e547313ebULL, 0x26d58a9c5ecf10c9ULL, 0x13478410f4c7ec73ULL,
+            0xf08aed437682d4fbULL, 0x1819651531f9e78fULL, 0xecada89454238a3aULL, 0x1e1fbe5a7e786173ULL,
+            0x73ec895cb4963664ULL, 0x12d3d6f88f0b3ce8ULL, 0x90e7abb3e1bbc3fdULL, 0x1788ccb6b2ce0c22ULL,
+            0x352196a0da2ab4fdULL, 0x1d6affe45f818f2bULL, 0x0134fe24885ab11eULL, 0x1262dfeebbb0f97bULL,
+            0xc1823dadaa715d65ULL, 0x16fb97ea6a9d37d9ULL, 0x31e2cd19150db4bfULL, 0x1cba7de5054485d0ULL,
+            0x1f2dc02fad2890f7ULL, 0x11f48eaf234ad3a2ULL, 0xa6f9303b9872b535ULL, 0x1671b25aec1d888aULL,
+            0x50b77c4a7e8f6282ULL, 0x1c0e1ef1a724eaadULL, 0x5272adae8f199d91ULL, 0x1188d357087712acULL,
+            0x670f591a32e004f6ULL, 0x15eb082cca94d757ULL, 0x40d32f60bf980633ULL, 0x1b65ca37fd3a0d2dULL,
+            0x4883fd9c77bf03e0ULL, 0x111f9e62fe44483cULL, 0x5aa4fd0395aec4d8ULL, 0x156785fbbdd55a4bULL,
+            0x314e3c447b1a760eULL, 0x1ac1677aad4ab0deULL, 0xded0e5aaccf089c9ULL, 0x10b8e0acac4eae8aULL,
+            0x96851f15802cac3bULL, 0x14e718d7d7625a2dULL, 0xfc2666dae037d74aULL, 0x1a20df0dcd3af0b8ULL,
+            0x9d980048cc22e68eULL, 0x10548b68a044d673ULL, 0x84fe005aff2ba032ULL, 0x1469ae42c8560c10ULL,
+            0xa63d8071bef6883eULL, 0x198419d37a6b8f14ULL, 0xcfcce08e2eb42a4eULL, 0x1fe52048590672d9ULL,
+            0x21e00c58dd309a70ULL, 0x13ef342d37a407c8ULL, 0x2a580f6f147cc10dULL, 0x18eb0138858d09baULL,
+            0xb4ee134ad99bf150ULL, 0x1f25c186a6f04c28ULL, 0x7114cc0ec80176d2ULL, 0x137798f428562f99ULL,
+            0xcd59ff127a01d486ULL, 0x18557f31326bbb7fULL, 0xc0b07ed7188249a8ULL, 0x1e6adefd7f06aa5fULL,
+            0xd86e4f466f516e09ULL, 0x1302cb5e6f642a7bULL, 0xce89e3180b25c98bULL, 0x17c37e360b3d351aULL,
+            0x822c5bde0def3beeULL, 0x1db45dc38e0c8261ULL, 0xf15bb96ac8b58575ULL, 0x1290ba9a38c7d17cULL,
+            0x2db2a7c57ae2e6d2ULL, 0x1734e940c6f9c5dcULL, 0x391f51b6d99ba086ULL, 0x1d022390f8b83753ULL,
+            0x03b3931248014454ULL, 0x1221563a9b732294ULL, 0x04a077d6da019569ULL, 0x16a9abc9424feb39ULL,
+            0x45c895cc9081fac3ULL, 0x1c5416bb92e3e607ULL, 0x8b9d5d9fda513cbaULL, 0x11b48e353bce6fc4ULL,
+            0xae84b507d0e58be8ULL, 0x1621b1c28ac20bb5ULL, 0x1a25e249c51eeee3ULL, 0x1baa1e332d728ea3ULL,
+            0xf057ad6e1b33554dULL, 0x114a52dffc679925ULL, 0x6c6d98c9a2002aa1ULL, 0x159ce797fb817f6fULL,
+            0x4788fefc0a803549ULL, 0x1b04217dfa61df4bULL, 0x0cb59f5d8690214eULL, 0x10e294eebc7d2b8fULL,
+            0xcfe30734e83429a1ULL, 0x151b3a2a6b9c7672ULL, 0x83dbc9022241340aULL, 0x1a6208b50683940fULL,
+            0xb2695da15568c086ULL, 0x107d457124123c89ULL, 0x1f03b509aac2f0a7ULL, 0x149c96cd6d16cbacULL,
+            0x26c4a24c1573acd1ULL, 0x19c3bc80c85c7e97ULL, 0x783ae56f8d684c03ULL, 0x101a55d07d39cf1eULL,
+            0x16499ecb70c25f03ULL, 0x1420eb449c8842e6ULL, 0x9bdc067e4cf2f6c4ULL, 0x19292615c3aa539fULL,
+            0x82d3081de02fb476ULL, 0x1f736f9b3494e887ULL, 0xb1c3e512ac1dd0c9ULL, 0x13a825c100dd1154ULL,
+            0xde34de57572544fcULL, 0x18922f31411455a9ULL, 0x55c215ed2cee963bULL, 0x1eb6bafd91596b14ULL,
+            0xb5994db43c151de5ULL, 0x133234de7ad7e2ecULL, 0xe2ffa1214b1a655eULL, 0x17fec216198ddba7ULL,
+            0xdbbf89699de0feb6ULL, 0x1dfe729b9ff15291ULL, 0x2957b5e202ac9f31ULL, 0x12bf07a143f6d39bULL,
+            0xf3ada35a8357c6feULL, 0x176ec98994f48881ULL, 0x70990c31242db8bdULL, 0x1d4a7bebfa31aaa2ULL,
+            0x865fa79eb69c9376ULL, 0x124e8d737c5f0aa5ULL, 0xe7f791866443b854ULL, 0x16e230d05b76cd4eULL,
+            0xa1f575e7fd54a669ULL, 0x1c9abd04725480a2ULL, 0xa53969b0fe54e801ULL, 0x11e0b622c774d065ULL,
+            0x0e87c41d3dea2202ULL, 0x1658e3ab7952047fULL, 0xd229b5248d64aa82ULL, 0x1bef1c9657a6859eULL,
+            0x435a1136d85eea91ULL, 0x117571ddf6c81383ULL, 0x143095848e76a536ULL, 0x15d2ce55747a1864ULL,
+            0x193cbae5b2144e83ULL, 0x1b4781ead1989e7dULL, 0x2fc5f4cf8f4cb112ULL, 0x110cb132c2ff630eULL,
+            0xbbb77203731fdd56ULL, 0x154fdd7f73bf3bd1ULL, 0x2aa54e844fe7d4acULL, 0x1aa3d4df50af0ac6ULL,
+            0xdaa75112b1f0e4ebULL, 0x10a6650b926d66bbULL, 0xd15125575e6d1e26ULL, 0x14cffe4e7708c06aULL,
+            0x85a56ead360865b0ULL, 0x1a03fde214caf085ULL, 0x7387652c41c53f8eULL, 0x10427ead4cfed653ULL,
+            0x50693e7752368f71ULL, 0x14531e58a03e8be8ULL, 0x64838e1526c4334eULL, 0x1967e5eec84e2ee2ULL,
+            0xfda4719a70754022ULL, 0x1fc1df6a7a61ba9aULL, 0xde86c70086494815ULL, 0x13d92ba28c7d14a0ULL,
+            0x162878c0a7db9a1aULL, 0x18cf768b2f9c59c9ULL, 0x5bb296f0d1d280a1ULL, 0x1f03542dfb83703bULL,
+            0x194f9e5683239064ULL, 0x1362149cbd322625ULL, 0x5fa385ec23ec747eULL, 0x183a99c3ec7eafaeULL,
+            0xf78c67672ce7919dULL, 0x1e494034e79e5b99ULL, 0x3ab7c0a07c10bb02ULL, 0x12edc82110c2f940ULL,
+            0x4965b0c89b14e9c3ULL, 0x17a93a2954f3b790ULL, 0x5bbf1cfac1da2433ULL, 0x1d9388b3aa30a574ULL,
+            0xb957721cb92856a0ULL, 0x127c35704a5e6768ULL, 0xe7ad4ea3e7726c48ULL, 0x171b42cc5cf60142ULL,
+            0xa198a24ce14f075aULL, 0x1ce2137f74338193ULL, 0x44ff65700cd16498ULL, 0x120d4c2fa8a030fcULL,
+            0x563f3ecc1005bdbeULL, 0x16909f3b92c83d3bULL, 0x2bcf0e7f14072d2eULL, 0x1c34c70a777a4c8aULL,
+            0x5b61690f6c847c3dULL, 0x11a0fc668aac6fd6ULL, 0xf239c35347a59b4cULL, 0x16093b802d578bcbULL,
+            0xeec83428198f021fULL, 0x1b8b8a6038ad6ebeULL, 0x553d20990ff96153ULL, 0x1137367c236c6537ULL,
+            0x2a8c68bf53f7b9a8ULL, 0x1585041b2c477e85ULL, 0x752f82ef28f5a812ULL, 0x1ae64521f7595e26ULL,
+            0x093db1d57999890bULL, 0x10cfeb353a97dad8ULL, 0x0b8d1e4ad7ffeb4eULL, 0x1503e602893dd18eULL,
+            0x8e7065dd8dffe622ULL, 0x1a44df832b8d45f1ULL, 0xf9063faa78bfefd5ULL, 0x106b0bb1fb384bb6ULL,
+            0xb747cf9516efebcaULL, 0x1485ce9e7a065ea4ULL, 0xe519c37a5cabe6bdULL, 0x19a742461887f64dULL,
+            0xaf301a2c79eb7036ULL, 0x1008896bcf54f9f0ULL, 0xdafc20b798664c43ULL, 0x140aabc6c32a386cULL,
+            0x11bb28e57e7fdf54ULL, 0x190d56b873f4c688ULL, 0x1629f31ede1fd72aULL, 0x1f50ac6690f1f82aULL,
+            0x4dda37f34ad3e67aULL, 0x13926bc01a973b1aULL, 0xe150c5f01d88e019ULL, 0x187706b0213d09e0ULL,
+            0x19a4f76c24eb181fULL, 0x1e94c85c298c4c59ULL, 0xb0071aa39712ef13ULL, 0x131cfd3999f7afb7ULL,
+            0x9c08e14c7cd7aad8ULL, 0x17e43c8800759ba5ULL, 0x030b199f9c0d958eULL, 0x1ddd4baa0093028fULL,
+            0x61e6f003c1887d79ULL, 0x12aa4f4a405be199ULL, 0xba60ac04b1ea9cd7ULL, 0x1754e31cd072d9ffULL,
+            0xa8f8d705de65440dULL, 0x1d2a1be4048f907fULL, 0xc99b8663aaff4a88ULL, 0x123a516e82d9ba4fULL,
+            0xbc0267fc95bf1d2aULL, 0x16c8e5ca239028e3ULL, 0xab0301fbbb2ee474ULL, 0x1c7b1f3cac74331cULL,
+            0xeae1e13d54fd4ec9ULL, 0x11ccf385ebc89ff1ULL, 0x659a598caa3ca27bULL, 0x1640306766bac7eeULL,
+            0xff00efefd4cbcb1aULL, 0x1bd03c81406979e9ULL, 0x3f6095f5e4ff5ef0ULL, 0x116225d0c841ec32ULL,
+            0xcf38bb735e3f36acULL, 0x15baaf44fa52673eULL, 0x8306ea5035cf0457ULL, 0x1b295b1638e7010eULL,
+            0x11e4527221a162b6ULL, 0x10f9d8ede39060a9ULL, 0x565d670eaa09bb64ULL, 0x15384f295c7478d3ULL,
+            0x2bf4c0d2548c2a3dULL, 0x1a8662f3b3919708ULL, 0x1b78f88374d79a66ULL, 0x1093fdd8503afe65ULL,
+            0x625736a4520d8100ULL, 0x14b8fd4e6449bdfeULL, 0xfaed044d6690e140ULL, 0x19e73ca1fd5c2d7dULL,
+            0xbcd422b0601a8cc8ULL, 0x103085e53e599c6eULL, 0x6c092b5c78212ffaULL, 0x143ca75e8df0038aULL,
+            0x070b763396297bf8ULL, 0x194bd136316c046dULL, 0x48ce53c07bb3daf6ULL, 0x1f9ec583bdc70588ULL,
+            0x2d80f4584d5068daULL, 0x13c33b72569c6375ULL, 0x78e1316e60a48310ULL, 0x18b40a4eec437c52ULL
+        };
+        return table;
+    }
+};
+
+// JsonSinkW receives the utf8 text written by BasicJsonW::write() in blocks.
+// Derive from it to send the text to a socket, a compressor or any other
+// destination.
+class JsonSinkW
+{
+public:
+    virtual ~JsonSinkW() {}
+
+    // receive the next block of text, return false to stop the writing
+    virtual bool write(const char* data, size_t length) = 0;
+};
+
+// JsonStreamSinkW writes the text into std::ostream
+class JsonStreamSinkW : public JsonSinkW
+{
+public:
+    explicit JsonStreamSinkW(std::ostream& os) : os_(os) {}
+
+    virtual bool write(const char* data, size_t length)
+    {
+        os_.write(data, (std::streamsize)length);
+        return os_.good();
+    }
+
+private:
+    std::ostream& os_;
+};
+
+#if defined(OCTILLION_JSONW_POSIX)
+// JsonFdSinkW writes the text into a file descriptor, such as a socket. The
+// descriptor is not closed.
+class JsonFdSinkW : public JsonSinkW
+{
+public:
+    explicit JsonFdSinkW(int fd) : fd_(fd) {}
+
+    virtual bool write(const char* data, size_t length)
+    {
+        while (length > 0)
+        {
+            ssize_t written = ::write(fd_, data, length);
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            else if (written <= 0)
+            {
+                return false;
+            }
+
+            data += written;
+            length -= (size_t)written;
+        }
+        return true;
+    }
+
+private:
+    int fd_;
+};
+#endif
+
+// JsonWriterW writes json tokens as utf8 text. It appends to a string that
+// grows as needed, fills a buffer of fixed capacity, or keeps a block of
+// BLOCK_SIZE bytes and passes it to a sink whenever the block is full. Wide
+// string is encoded one character at a time, the whole text is never held
+// in wchar_t. JsonW caller does not need to access this class at all.
+class JsonWriterW
+{
+public:
+    const static size_t BLOCK_SIZE = 64 * 1024;
+
+public:
+    // append the text to 'buffer', flush() trims the unused space
+    explicit JsonWriterW(std::string& buffer)
+        : string_(&buffer), sink_(nullptr), offset_(buffer.size()),
+          passed_(0), dropped_(0), good_(true)
+    {
+        string_->resize(offset_ + 256);
+        reset(offset_);
+    }
+
+    // pass the text to 'sink' in blocks, flush() passes the last block
+    explicit JsonWriterW(JsonSinkW& sink)
+        : string_(nullptr), sink_(&sink), block_(BLOCK_SIZE, '\0'), offset_(0),
+          passed_(0), dropped_(0), good_(true)
+    {
+        begin_ = cur_ = &block_[0];
+        end_ = begin_ + block_.size();
+    }
+
+    // write the text into 'buffer' of 'capacity' bytes, the text beyond the
+    // capacity is counted but not written
+    JsonWriterW(char* buffer, size_t capacity)
+        : string_(nullptr), sink_(nullptr), begin_(buffer), cur_(buffer),
+          end_(buffer + capacity), offset_(0), passed_(0), dropped_(0), good_(true)
+    {
+    }
+
+    // false if sink has stopped the writing or the value is invalid
+    bool good() const { return good_; }
+
+    // stop the writing of invalid value, flush() drops the text appended
+    // to the string and length() is 0
+    void fail()
+    {
+        good_ = false;
+        failed_ = true;
+    }
+
+    // length of the text written so far, including the text that does not
+    // fit in the buffer of fixed capacity
+    size_t length() const { return failed_ ? 0 : passed_ + (size_t)(cur_ - begin_) + dropped_; }
+
+    void put(char ch)
+    {
+        if (cur_ < end_)
+        {
+            *cur_++ = ch;
+        }
+        else
+        {
+            spill(&ch, 1);
+        }
+    }
+
+    void write(const char* data, size_t length)
+    {
+        if ((size_t)(end_ - cur_) >= length)
+        {
+            std::memcpy(cur_, data, length);
+            cur_ += length;
+        }
+        else
+        {
+            spill(data, length);
+        }
+    }
+
+    void integer(long long integer)
+    {
+        char buffer[JsonFormatW::BUFFER_SIZE];
+        write(buffer, JsonFormatW::integer(integer, buffer));
+    }
+
+    void integer(unsigned long long integer)
+    {
+        char buffer[JsonFormatW::BUFFER_SIZE];
+        write(buffer, JsonFormatW::integer(integer, buffer));
+    }
+
+    void frac(long double frac)
+    {
+        char buffer[JsonFormatW::BUFFER_SIZE];
+        write(buffer, JsonFormatW::frac(frac, buffer));
+    }
+
+    // write quoted and escaped utf8 string
+    void string(const char* text, size_t length)
+    {
+        const char* cur = text;
+        const char* end = text + length;
+
+        put('\"');
+
+        while (cur < end)
+        {
+            const char* run = JsonSimdW::findescape(cur, end);
+            write(cur, (size_t)(run - cur));
+
+            if (run >= end)
+            {
+                break;
+            }
+
+            escape((unsigned char)*run);
+            cur = run + 1;
+        }
+
+        put('\"');
+    }
+
+    // write quoted and escaped ucs string in utf8, surrogate pair is
+    // joined into one character and a lone surrogate, which utf8 cannot
+    // encode, is written as \uXXXX escape. Throw std::range_error for
+    // character above U+10FFFF as std::wstring_convert does
+    void string(const wchar_t* text, size_t length)
+    {
+        const wchar_t* cur = text;
+        const wchar_t* end = text + length;
+
+        put('\"');
+
+        while (cur < end)
+        {
+            const wchar_t* run = JsonSimdW::findescape(cur, end);
+
+            for (; cur < run; cur++)
+            {
+                uint32_t ch = (uint32_t)*cur;
+
+                if (ch < 0x80)
+                {
+                    put((char)ch);
+                }
+                else if (ch >= 0xD800 && ch <= 0xDBFF && cur + 1 < run &&
+                    (uint32_t)cur[1] >= 0xDC00 && (uint32_t)cur[1] <= 0xDFFF)
+                {
+                    encode(0x10000 + ((ch - 0xD800) << 10) + ((uint32_t)cur[1] - 0xDC00));
+                    cur++;
+                }
+                else if (ch >= 0xD800 && ch <= 0xDFFF)
+                {
+                    static const char digits[] = "0123456789abcdef";
+                    char bytes[] = { '\\', 'u', digits[(ch >> 12) & 0xF], digits[(ch >> 8) & 0xF],
+                        digits[(ch >> 4) & 0xF], digits[ch & 0xF] };
+                    write(bytes, 6);
+                }
+                else
+                {
+                    encode(ch);
+                }
+            }
+
+            if (run >= end)
+            {
+                break;
+            }
+
+            escape((uint32_t)*run);
+            cur = run + 1;
+        }
+
+        put('\"');
+    }
+
+    // pass the rest of the text to sink, or trim the string. Return false
+    // if sink has stopped the writing or the value is invalid.
+    bool flush()
+    {
+        if (string_ != nullptr)
+        {
+            size_t used = failed_ ? offset_ : (size_t)(cur_ - &(*string_)[0]);
+            string_->resize(used);
+            reset(used);
+        }
+        else if (sink_ != nullptr && good_ && cur_ != begin_)
+        {
+            pass();
+        }
+
+        return good_;
+    }
+
+private:
+    // point to the string after it is resized, 'used' bytes are written
+    void reset(size_t used)
+    {
+        char* data = &(*string_)[0];
+        begin_ = data + offset_;
+        cur_ = data + used;
+        end_ = data + string_->size();
+    }
+
+    // write the data that does not fit in the space left
+    void spill(const char* data, size_t length)
+    {
+        while (length > 0)
+        {
+            if (cur_ == end_ && !more(length))
+            {
+                dropped_ += length;
+                return;
+            }
+
+            size_t part = std::min(length, (size_t)(end_ - cur_));
+            std::memcpy(cur_, data, part);
+            cur_ += part;
+            data += part;
+            length -= part;
+        }
+    }
+
+    // make space for 'length' bytes, return false if there is no more space
+    bool more(size_t length)
+    {
+        if (string_ != nullptr)
+        {
+            size_t used = (size_t)(cur_ - &(*string_)[0]);
+            string_->resize(std::max(used + length, string_->size() * 2));
+            reset(used);
+            return true;
+        }
+        else if (sink_ != nullptr && good_)
+        {
+            return pass();
+        }
+
+        return false;
+    }
+
+    // pass the block to sink, the text written after sink has stopped is
+    // dropped
+    bool pass()
+    {
+        good_ = sink_->write(begin_, (size_t)(cur_ - begin_));
+        passed_ += (size_t)(cur_ - begin_);
+        cur_ = begin_;
+        return good_;
+    }
+
+    // the escaped form of the characters found by findescape()
+    void escape(uint32_t ch)
+    {
+        switch (ch)
+        {
+        case 0x22: write("\\\"", 2); break;
+        case 0x5C: write("\\\\", 2); break;
+        case 0x2F: write("\\/", 2); break;
+        case 0x08: write("\\b", 2); break;
+        case 0x0C: write("\\f", 2); break;
+        case 0x0A: write("\\n", 2); break;
+        case 0x0D: write("\\r", 2); break;
+        case 0x09: write("\\t", 2); break;
+        default: encode(ch);
+        }
+    }
+
+    void encode(uint32_t ch)
+    {
+        if (ch < 0x80)
+        {
+            put((char)ch);
+        }
+        else if (ch < 0x800)
+        {
+            char bytes[] = { (char)(0xC0 | (ch >> 6)), (char)(0x80 | (ch & 0x3F)) };
+            write(bytes, 2);
+        }
+        else if (ch < 0x10000)
+        {
+            char bytes[] = { (char)(0xE0 | (ch >> 12)), (char)(0x80 | ((ch >> 6) & 0x3F)),
+                (char)(0x80 | (ch & 0x3F)) };
+            write(bytes, 3);
+        }
+        else if (ch < 0x110000)
+        {
+            char bytes[] = { (char)(0xF0 | (ch >> 18)), (char)(0x80 | ((ch >> 12) & 0x3F)),
+                (char)(0x80 | ((ch >> 6) & 0x3F)), (char)(0x80 | (ch & 0x3F)) };
+            write(bytes, 4);
+        }
+        else
+        {
+            throw std::range_error("wstring_convert::to_bytes");
+        }
+    }
+
+private:
+    std::string* string_;
+    JsonSinkW* sink_;
+    std::string block_;
+    char* begin_ = nullptr;
+    char* cur_ = nullptr;
+    char* end_ = nullptr;
+    size_t offset_;
+    size_t passed_;
+    size_t dropped_;
+    bool good_;
+    bool failed_ = false;
+};
+
+// JsonCounterW takes the same calls as JsonWriterW, but only counts the
+// bytes of the utf8 text and its characters. A character is a wchar_t of
+// ucs string or a utf8 sequence, escape sequence is two characters. JsonW
+// caller does not need to access this class at all.
+class JsonCounterW
+{
+public:
+    bool good() const { return !failed_; }
+
+    // invalid value has no text
+    void fail() { failed_ = true; }
+
+    size_t bytes() const { return failed_ ? 0 : bytes_; }
+
+    size_t characters() const { return failed_ ? 0 : characters_; }
+
+    // true if a ucs character has no utf8 form
+    bool invalid() const { return invalid_; }
+
+    // ascii only
+    void put(char) { bytes_++; characters_++; }
+
+    // ascii only
+    void write(const char*, size_t length) { bytes_ += length; characters_ += length; }
+
+    void integer(long long integer)
+    {
+        char buffer[JsonFormatW::BUFFER_SIZE];
+        write(buffer, JsonFormatW::integer(integer, buffer));
+    }
+
+    void frac(long double frac)
+    {
+        char buffer[JsonFormatW::BUFFER_SIZE];
+        write(buffer, JsonFormatW::frac(frac, buffer));
+    }
+
+    void string(const char* text, size_t length)
+    {
+        bytes_ += length + 2;
+        characters_ += 2;
+
+        for (const char* cur = text; cur < text + length; cur++)
+        {
+            unsigned char ch = (unsigned char)*cur;
+
+            if (escaped(ch))
+            {
+                bytes_++;
+                characters_ += 2;
+            }
+            else if ((ch & 0xC0) != 0x80)
+            {
+                characters_++;
+            }
+        }
+    }
+
+    void string(const wchar_t* text, size_t length)
+    {
+        bytes_ += 2;
+        characters_ += length + 2;
+
+        for (const wchar_t* cur = text; cur < text + length; cur++)
+        {
+            uint32_t ch = (uint32_t)*cur;
+
+            if (ch < 0x80)
+            {
+                bytes_ += escaped(ch) ? 2 : 1;
+                characters_ += escaped(ch) ? 1 : 0;
+            }
+            else if (ch >= 0xD800 && ch <= 0xDBFF && cur + 1 < text + length &&
+                (uint32_t)cur[1] >= 0xDC00 && (uint32_t)cur[1] <= 0xDFFF)
+            {
+                // surrogate pair is one character in utf8
+                bytes_ += 4;
+                cur++;
+            }
+            else if (ch >= 0xD800 && ch <= 0xDFFF)
+            {
+                // lone surrogate is \uXXXX escape
+                bytes_ += 6;
+                characters_ += 5;
+            }
+            else
+            {
+                bytes_ += ch < 0x800 ? 2 : (ch < 0x10000 ? 3 : 4);
+                invalid_ = invalid_ || ch >= 0x110000;
+            }
+        }
+    }
+
+private:
+    static bool escaped(uint32_t ch)
+    {
+        return ch == 0x22 || ch == 0x5C || ch == 0x2F || ch == 0x08 ||
+            ch == 0x0C || ch == 0x0A || ch == 0x0D || ch == 0x09;
+    }
+
+private:
+    size_t bytes_ = 0;
+    size_t characters_ = 0;
+    bool invalid_ = false;
+    bool failed_ = false;
+};
+
+// JsonNativeWriterW takes the same calls as JsonWriterW and appends the text
+// of CharT to a string, which is the text of native(). JsonW caller does not
+// need to access this class at all.
+template <typename CharT>
+class JsonNativeWriterW
+{
+public:
+    explicit JsonNativeWriterW(std::basic_string<CharT>& buffer) : buffer_(buffer) {}
+
+    bool good() const { return !failed_; }
+
+    // invalid value has no text, see native()
+    void fail() { failed_ = true; }
+
+    void put(char ch) { buffer_.push_back((CharT)ch); }
+
+    void write(const char* data, size_t length) { buffer_.append(data, data + length); }
+
+    void integer(long long integer)
+    {
+        char buffer[JsonFormatW::BUFFER_SIZE];
+        write(buffer, JsonFormatW::integer(integer, buffer));
+    }
+
+    void frac(long double frac)
+    {
+        char buffer[JsonFormatW::BUFFER_SIZE];
+        write(buffer, JsonFormatW::frac(frac, buffer));
+    }
+
+    // write quoted and escaped string
+    void string(const CharT* text, size_t length)
+    {
+        const CharT* cur = text;
+        const CharT* end = text + length;
+
+        put('\"');
+
+        while (cur < end)
+        {
+            const CharT* run = JsonSimdW::findescape(cur, end);
+            buffer_.append(cur, run);
+
+            if (run >= end)
+            {
+                break;
+            }
+
+            switch (*run)
+            {
+            case 0x22: write("\\\"", 2); break;
+            case 0x5C: write("\\\\", 2); break;
+            case 0x2F: write("\\/", 2); break;
+            case 0x08: write("\\b", 2); break;
+            case 0x0C: write("\\f", 2); break;
+            case 0x0A: write("\\n", 2); break;
+            case 0x0D: write("\\r", 2); break;
+            case 0x09: write("\\t", 2); break;
+            default: buffer_.push_back(*run);
+            }
+            cur = run + 1;
+        }
+
+        put('\"');
+    }
+
+private:
+    std::basic_string<CharT>& buffer_;
+    bool failed_ = false;
+};
+
+// JsonBytesW appends the bytes of MessagePack or CBOR to a byte buffer, the
+// numbers are written in big endian and the strings in utf8. JsonW caller
+// does not need to access this class at all.
+class JsonBytesW
+{
+public:
+    // append the bytes to 'buffer', flush() trims the unused space
+    explicit JsonBytesW(std::vector<uint8_t>& buffer)
+        : buffer_(buffer), start_(buffer.size()), used_(buffer.size())
+    {
+        buffer_.resize(used_ + 256);
+    }
+
+    bool good() const { return !failed_; }
+
+    // value that cannot be encoded has no bytes, flush() drops the bytes
+    // appended to the buffer
+    void fail() { failed_ = true; }
+
+    void put(uint8_t byte)
+    {
+        reserve(1);
+        buffer_[used_++] = byte;
+    }
+
+    // 'prefix' followed by the lowest 'length' bytes of 'value'
+    void put(uint8_t prefix, uint64_t value, size_t length)
+    {
+        reserve(length + 1);
+
+        uint8_t* cur = &buffer_[used_];
+        *cur++ = prefix;
+        for (size_t i = length; i > 0; i--)
+        {
+            *cur++ = (uint8_t)(value >> (8 * (i - 1)));
+        }
+        used_ += length + 1;
+    }
+
+    // single precision number after 'single' if it keeps the value,
+    // otherwise double precision number after 'dual'
+    void frac(uint8_t single, uint8_t dual, double frac)
+    {
+        float narrow = (float)frac;
+
+        if ((double)narrow == frac)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &narrow, sizeof(bits));
+            put(single, bits, 4);
+        }
+        else
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &frac, sizeof(bits));
+            put(dual, bits, 8);
+        }
+    }
+
+    // length of the string in utf8, throw std::range_error for character
+    // above U+10FFFF as std::wstring_convert does
+    static size_t utf8length(const char*, size_t length)
+    {
+        return length;
+    }
+
+    static size_t utf8length(const wchar_t* text, size_t length)
+    {
+        size_t bytes = 0;
+
+        for (const wchar_t* cur = text; cur < text + length; )
+        {
+            uint32_t ch = character(cur, text + length);
+
+            if (ch >= 0x110000)
+            {
+                throw std::range_error("wstring_convert::to_bytes");
+            }
+            bytes += ch < 0x80 ? 1 : (ch < 0x800 ? 2 : (ch < 0x10000 ? 3 : 4));
+        }
+
+        return bytes;
+    }
+
+    // write the string of 'bytes' bytes in utf8, ucs string is encoded
+    // one character() at a time
+    void utf8(const char* text, size_t length, size_t)
+    {
+        reserve(length);
+        std::memcpy(&buffer_[used_], text, length);
+        used_ += length;
+    }
+
+    void utf8(const wchar_t* text, size_t length, size_t bytes)
+    {
+        reserve(bytes);
+
+        uint8_t* cur = &buffer_[used_];
+        for (const wchar_t* end = text + length; text < end; )
+        {
+            uint32_t ch = character(text, end);
+
+            if (ch < 0x80)
+            {
+                *cur++ = (uint8_t)ch;
+            }
+            else if (ch < 0x800)
+            {
+                *cur++ = (uint8_t)(0xC0 | (ch >> 6));
+                *cur++ = (uint8_t)(0x80 | (ch & 0x3F));
+            }
+            else if (ch < 0x10000)
+            {
+                *cur++ = (uint8_t)(0xE0 | (ch >> 12));
+                *cur++ = (uint8_t)(0x80 | ((ch >> 6) & 0x3F));
+                *cur++ = (uint8_t)(0x80 | (ch & 0x3F));
+            }
+            else
+            {
+                *cur++ = (uint8_t)(0xF0 | (ch >> 18));
+                *cur++ = (uint8_t)(0x80 | ((ch >> 12) & 0x3F));
+                *cur++ = (uint8_t)(0x80 | ((ch >> 6) & 0x3F));
+                *cur++ = (uint8_t)(0x80 | (ch & 0x3F));
+            }
+        }
+        used_ += bytes;
+    }
+
+    // read one character of ucs string at 'cur', surrogate pair is joined
+    // and a lone surrogate, which utf8 cannot encode, is U+FFFD as utf8
+    // string keeps it
+    static uint32_t character(const wchar_t*& cur, const wchar_t* end)
+    {
+        uint32_t ch = (uint32_t)*cur++;
+
+        if (ch >= 0xD800 && ch <= 0xDBFF && cur < end &&
+            (uint32_t)*cur >= 0xDC00 && (uint32_t)*cur <= 0xDFFF)
+        {
+            return 0x10000 + ((ch - 0xD800) << 10) + ((uint32_t)*cur++ - 0xDC00);
+        }
+
+        return (ch >= 0xD800 && ch <= 0xDFFF) ? 0xFFFD : ch;
+    }
+
+    // trim the unused space
+    void flush()
+    {
+        buffer_.resize(failed_ ? start_ : used_);
+    }
+
+private:
+    // make space for 'length' more bytes
+    void reserve(size_t length)
+    {
+        if (buffer_.size() - used_ < length)
+        {
+            buffer_.resize(std::max(used_ + length, buffer_.size() * 2));
+        }
+    }
+
+private:
+    std::vector<uint8_t>& buffer_;
+    size_t start_;
+    size_t used_;
+    bool failed_ = false;
+};
+
+// JsonTokenW presents a token in json data. It has a static member function 
+// 'parse()' that can parse the json from text to token. JsonW does not use
+// the tokens, it parses text in single pass with the static scanner functions
+// of this class. JsonW caller does not need to access this class at all. See
+// README.md for detail.
+class JsonTokenW
+{
+public:
+    enum class Type
+    {
+        NumberInteger,
+        NumberFloat,
+        String,
+        LeftCurlyBracket,
+        RightCurlyBracket,
+        LeftSquareBracket,
+        RightSquareBracket,
+        Colon,
+        Comma,
+        Boolean,
+        Null,
+        Bad
+    };
+
+public:
+    // parse json text from wistream instead of istream
+    JsonTokenW(std::wistream& ins)
+    {
+        type_ = Type::Bad;
+        wchar_t character;
+
+        if (!ins.good())
+        {
+            return;
+        }
+
+        character = ins.peek();
+
+        // return false if no more data to read
+        if (character == std::char_traits<wchar_t>::eof())
+        {
+            return;
+        }
+
+        // handle single character token
+        switch (character)
+        {
+        case L'{': type_ = Type::LeftCurlyBracket;  ins.get(); return;
+        case L'}': type_ = Type::RightCurlyBracket; ins.get(); return;
+        case L'[': type_ = Type::LeftSquareBracket;   ins.get(); return;
+        case L']': type_ = Type::RightSquareBracket;  ins.get(); return;
+        case L':': type_ = Type::Colon;              ins.get(); return;
+        case L',': type_ = Type::Comma;              ins.get(); return;
+        }
+
+        // handle number
+        if (iswdigit(character) || character == L'-')
+        {
+            std::wstring numberstr;
+            bool containdot = false;
+            bool containexp = false;
+            bool negativeexp = false;
+            int64_t exponent = 0;
+
+            // negative value
+            if (character == L'-')
+            {
+                numberstr.push_back(character);
+                ins.get();
+                character = ins.peek();
+            }
+
+            // if start with 0, it must followed by ., exponent or standalone zero
+            if (character == L'0')
+            {
+                numberstr.push_back(character);
+                ins.get();
+                character = ins.peek();
+
+                if (character != L'.' && character != L'e' && character != L'E')
+                {
+                    type_ = Type::NumberInteger;
+                    integer_ = 0;
+                    return;
+                }
+
+                if (character == L'.')
+                {
+                    containdot = true;
+                    numberstr.push_back(character);
+                    ins.get();
+                    character = ins.peek();
+                }
+            }
+
+            while (iswdigit(character) || character == L'.' || character == L'e' || character == L'E')
+            {
+                // handle .
+                if (character == L'.')
+                {
+                    if (containdot || numberstr.length() == 0)
+                    {
+                        return;
+                    }
+                    else if (numberstr.length() == 1 && !iswdigit(numberstr.at(0)))
+                    {
+                        return;
+                    }
+                    else
+                    {
+                        containdot = true;
+                    }
+                }
+
+                if (character == L'e' || character == L'E')
+                {
+                    containexp = true;
+                    break;
+                }
+
+                numberstr.push_back(character);
+                ins.get();
+                character = ins.peek();
+            }
+
+            // last character in numberstr has to be a digit
+            if (numberstr.length() == 0 || !iswdigit(numberstr.back()))
+            {
+                return;
+            }
+
+            // first digit cannot be zero except frac or zero
+            if (!containdot && numberstr.at(0) == L'0' && numberstr.length() > 1)
+            {
+                return;
+            }
+
+            // handle exponent notation
+            if (character == L'e' || character == L'E')
+            {
+                ins.get();
+                character = ins.peek();
+                if (character == L'-')
+                {
+                    negativeexp = true;
+                    ins.get();
+                    character = ins.peek();
+                }
+
+                if (character == L'+')
+                {
+                    ins.get();
+                    character = ins.peek();
+                }
+
+                if (!iswdigit(character))
+                {
+                    return;
+                }
+
+                while (iswdigit(character))
+                {
+                    exponent = addexponent(exponent, character);
+                    ins.get();
+                    character = ins.peek();
+                }
+            }
+
+            type_ = number(numberstr.data(), numberstr.data() + numberstr.length(),
+                containdot || containexp, negativeexp ? -exponent : exponent, integer_, frac_);
+
+            return;
+        }
+
+        // handle 'true'
+        if (character == L't')
+        {
+            ins.get();
+            character = ins.peek();
+            if (character == std::char_traits<wchar_t>::eof() || character != L'r')
+            {
+                return;
+            }
+
+            ins.get();
+            character = ins.peek();
+            if (character == std::char_traits<wchar_t>::eof() || character != L'u')
+            {
+                return;
+            }
+
+            ins.get();
+            character = ins.peek();
+            if (character == std::char_traits<wchar_t>::eof() || character != L'e')
+            {
+                return;
+            }
+
+            ins.get();
+            type_ = Type::Boolean;
+            boolean_ = true;
+            return;
+        }
+
+        // handle 'false'
+        if (character == L'f')
+        {
+            ins.get();
+            character = ins.peek();
+            if (character == std::char_traits<wchar_t>::eof() || character != L'a')
+            {
+                return;
+            }
+
+            ins.get();
+            character = ins.peek();
+            if (character == std::char_traits<wchar_t>::eof() || character != L'l')
+            {
+                return;
+            }
+
+            ins.get();
+            character = ins.peek();
+            if (character == std::char_traits<wchar_t>::eof() || character != L's')
+            {
+                return;
+            }
+
+            ins.get();
+            character = ins.peek();
+            if (character == std::char_traits<wchar_t>::eof() || character != L'e')
+            {
+                return;
+            }
+
+            ins.get();
+            type_ = Type::Boolean;
+            boolean_ = false;
+            return;
+        }
+
+        // handle 'null'
+        if (character == L'n')
+        {
+            ins.get();
+            character = ins.peek();
+            if (character == std::char_traits<wchar_t>::eof() || character != L'u')
+            {
+                return;
+            }
+
+            ins.get();
+            character = ins.peek();
+            if (character == std::char_traits<wchar_t>::eof() || character != L'l')
+            {
+                return;
+            }
+
+            ins.get();
+            character = ins.peek();
+            if (character == std::char_traits<wchar_t>::eof() || character != L'l')
+            {
+                return;
+            }
+
+            ins.get();
+            type_ = Type::Null;
+            return;
+        }
+
+        // the only remaining possible token is string, must start with \"
+        if (character != L'\"')
+        {
+            return;
+        }
+
+        // consume \"
+        ins.get();
+        character = ins.peek();
+
+        // handle string
+        bool backslash = false;
+        std::wstring strbuf;
+
+        while (character != std::char_traits<wchar_t>::eof())
+        {
+            if (backslash)
+            {
+                // previous character is backslash
+                if (character == L'u')
+                {
+                    // special case for \u
+                    std::wstring hexbuf(L"0x");
+                    ins.get();
+                    hexbuf.push_back(ins.get());
+                    hexbuf.push_back(ins.get());
+                    hexbuf.push_back(ins.get());
+                    hexbuf.push_back(ins.get());
+
+                    if (hexbuf.at(2) == std::char_traits<wchar_t>::eof() ||
+                        hexbuf.at(3) == std::char_traits<wchar_t>::eof() ||
+                        hexbuf.at(4) == std::char_traits<wchar_t>::eof() ||
+                        hexbuf.at(5) == std::char_traits<wchar_t>::eof())
+                    {
+                        return;
+                    }
+
+                    try
+                    {
+                        unsigned int charvalue = std::stoul(hexbuf, NULL, 16);
+                        strbuf.push_back((wchar_t)charvalue);
+                        character = ins.peek();
+                        backslash = false;
+                        continue;
+                    }
+                    catch (const std::invalid_argument&)
+                    {
+                        return;
+                    }
+                    catch (const std::out_of_range&)
+                    {
+                        return;
+                    }
+                }
+
+                // other single character cases
+                switch (character)
+                {
+                case L'\"': strbuf.push_back(L'\"'); break;
+                case L'\\': strbuf.push_back(L'\\'); break;
+                case L'/': strbuf.push_back(L'/'); break;
+                case L'b':  strbuf.push_back((wchar_t)0x08); break;
+                case L'f':  strbuf.push_back((wchar_t)0x0c); break;
+                case L'n':  strbuf.push_back(L'\n'); break;
+                case L'r':  strbuf.push_back(L'\r'); break;
+                case L't':  strbuf.push_back(L'\t'); break;
+                }
+
+                ins.get();
+                character = ins.peek();
+                backslash = false;
+                continue;
+            }
+            else if (character == L'\\')
+            {
+                // special , set flag and fo next round
+                backslash = true;
+                ins.get();
+                character = ins.peek();
+                continue;
+            }
+            else if (character == L'\r' || character == L'\n')
+            {
+                // unexpected EOL
+                return;
+            }
+            else if (character == L'\"')
+            {
+                ins.get();
+                type_ = Type::String;
+                wstring_ = strbuf;
+                return;
+            }
+            else
+            {
+                strbuf.push_back(character);
+                ins.get();
+                character = ins.peek();
+            }
+        }
+
+        // unexpected EOF
+        return;
+    }
+
+public:
+    enum Type type() const { return type_; }
+    int_fast64_t integer() const { return integer_; }
+    long double frac() const { return frac_; }
+    std::wstring wstring() const { return wstring_; }
+    bool boolean() const { return boolean_; }
+
+private:
+    // determine if  character is white space for json
+    static bool isskippable(wchar_t character)
+    {
+        if (character == L' ' || character == L'\r' || character == L'\n' || character == L'\t')
+        {
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // convert the number text [begin, last) into integer or frac, the text
+    // has been checked by caller. Number with dot or exponent is a frac of
+    // the nearest double, or of long double above the double range. Return
+    // Bad if the number is out of range.
+    template <typename CharT>
+    static Type number(const CharT* begin, const CharT* last, bool isfrac, int64_t exponent,
+        int_fast64_t& integer, long double& frac)
+    {
+        if (isfrac)
+        {
+            double value;
+            if (!JsonFloatW::convert(begin, last, exponent, value))
+            {
+                return JsonFloatW::extended(begin, last, exponent, frac) ? Type::NumberFloat : Type::Bad;
+            }
+
+            frac = value;
+            return Type::NumberFloat;
+        }
+
+        // accumulate the magnitude in unsigned, negative value may have
+        // one more than the maximum positive value
+        bool negative = *begin == '-';
+        uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+        uint64_t magnitude = 0;
+
+        for (const CharT* cur = negative ? begin + 1 : begin; cur < last; cur++)
+        {
+            uint64_t digit = (uint64_t)(*cur - '0');
+            if (magnitude > (limit - digit) / 10)
+            {
+                return Type::Bad;
+            }
+            magnitude = magnitude * 10 + digit;
+        }
+
+        integer = negative ? (int_fast64_t)(0 - magnitude) : (int_fast64_t)magnitude;
+        return Type::NumberInteger;
+    }
+
+    // add one exponent digit, large exponent is saturated since it is out
+    // of double range anyway
+    template <typename CharT>
+    static int64_t addexponent(int64_t exponent, CharT character)
+    {
+        return exponent < 100000000 ? exponent * 10 + (character - '0') : exponent;
+    }
+
+    // determine if character is a decimal digit, ascii only
+    template <typename CharT>
+    static bool isdigitchar(CharT character)
+    {
+        return character >= '0' && character <= '9';
+    }
+
+    // determine if character is ascii, which is never part of a multi-byte
+    // utf8 sequence
+    template <typename CharT>
+    static bool isasciichar(CharT character)
+    {
+        return character >= 0 && character < 0x80;
+    }
+
+    // return the value of hex digit, -1 if character is not a hex digit
+    template <typename CharT>
+    static int hexdigit(CharT character)
+    {
+        if (character >= '0' && character <= '9') return character - '0';
+        if (character >= 'a' && character <= 'f') return character - 'a' + 10;
+        if (character >= 'A' && character <= 'F') return character - 'A' + 10;
+        return -1;
+    }
+
+    // append one non-ascii character at 'cur' to the string. utf8 text
+    // is decoded into ucs string or validated and copied into utf8 string,
+    // ucs text is copied into ucs string or encoded into utf8 string.
+    static bool append(const char*& cur, const char* end, std::wstring& wstr)
+    {
+        unsigned long codepoint;
+        if (!utf8decode(cur, end, codepoint))
+        {
+            return false;
+        }
+
+        ucsencode(codepoint, wstr);
+        return true;
+    }
+
+    static bool append(const char*& cur, const char* end, std::string& str)
+    {
+        const char* begin = cur;
+        unsigned long codepoint;
+        if (!utf8decode(cur, end, codepoint))
+        {
+            return false;
+        }
+
+        str.append(begin, cur);
+        return true;
+    }
+
+    static bool append(const wchar_t*& cur, const wchar_t*, std::wstring& wstr)
+    {
+        wstr.push_back(*cur);
+        cur++;
+        return true;
+    }
+
+    static bool append(const wchar_t*& cur, const wchar_t* end, std::string& str)
+    {
+        unsigned long codepoint = (unsigned long)*cur;
+        cur++;
+
+        // surrogate pair of 2 bytes wchar_t (Windows)
+        if (codepoint >= 0xD800 && codepoint <= 0xDBFF && cur < end &&
+            (unsigned long)*cur >= 0xDC00 && (unsigned long)*cur <= 0xDFFF)
+        {
+            codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + ((unsigned long)*cur - 0xDC00);
+            cur++;
+        }
+
+        utf8encode(codepoint, str);
+        return true;
+    }
+
+    // append the plain text [cur, run) found by plain() to the string
+    static void appendrun(const char* cur, const char* run, std::wstring& wstr)
+    {
+        for (; cur < run; cur++)
+        {
+            wstr.push_back((wchar_t)*cur);
+        }
+    }
+
+    static void appendrun(const char* cur, const char* run, std::string& str)
+    {
+        str.append(cur, run);
+    }
+
+    static void appendrun(const wchar_t* cur, const wchar_t* run, std::wstring& wstr)
+    {
+        wstr.append(cur, run);
+    }
+
+    static void appendrun(const wchar_t* cur, const wchar_t* run, std::string& str)
+    {
+        while (cur < run)
+        {
+            append(cur, run, str);
+        }
+    }
+
+    // append the value of \uXXXX escape. ucs string keeps the value as it
+    // is except a surrogate pair of 4 bytes wchar_t (Linux), which is one
+    // character as the same text in utf8 is. utf8 string joins surrogate
+    // pair and replaces a lone surrogate with U+FFFD since it cannot be
+    // encoded.
+    template <typename CharT>
+    static void appendescape(unsigned int charvalue, const CharT*& cur, const CharT* end, std::wstring& wstr)
+    {
+        unsigned int low = 0;
+
+        if (sizeof(wchar_t) == 4 && charvalue >= 0xD800 && charvalue <= 0xDBFF &&
+            end - cur >= 6 && cur[0] == '\\' && cur[1] == 'u' && hex4(cur + 2, low) &&
+            low >= 0xDC00 && low <= 0xDFFF)
+        {
+            ucsencode(0x10000 + ((charvalue - 0xD800) << 10) + (low - 0xDC00), wstr);
+            cur += 6;
+            return;
+        }
+
+        wstr.push_back((wchar_t)charvalue);
+    }
+
+    template <typename CharT>
+    static void appendescape(unsigned int charvalue, const CharT*& cur, const CharT* end, std::string& str)
+    {
+        unsigned long codepoint = charvalue;
+
+        if (charvalue >= 0xD800 && charvalue <= 0xDBFF)
+        {
+            unsigned int low = 0;
+            const CharT* next = cur;
+
+            if (end - next >= 6 && next[0] == '\\' && next[1] == 'u' && hex4(next + 2, low) &&
+                low >= 0xDC00 && low <= 0xDFFF)
+            {
+                codepoint = 0x10000 + ((charvalue - 0xD800) << 10) + (low - 0xDC00);
+                cur += 6;
+            }
+            else
+            {
+                codepoint = 0xFFFD;
+            }
+        }
+        else if (charvalue >= 0xDC00 && charvalue <= 0xDFFF)
+        {
+            codepoint = 0xFFFD;
+        }
+
+        utf8encode(codepoint, str);
+    }
+
+    // read exactly 4 hex digits
+    template <typename CharT>
+    static bool hex4(const CharT* cur, unsigned int& value)
+    {
+        value = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            int digit = hexdigit(cur[i]);
+            if (digit < 0)
+            {
+                return false;
+            }
+            value = (value << 4) | digit;
+        }
+        return true;
+    }
+
+    // append code point to ucs string, a character outside BMP is stored
+    // as surrogate pair if wchar_t is 2 bytes (Windows)
+    static void ucsencode(unsigned long codepoint, std::wstring& wstr)
+    {
+        if (sizeof(wchar_t) == 2 && codepoint > 0xFFFF)
+        {
+            codepoint -= 0x10000;
+            wstr.push_back((wchar_t)(0xD800 + (codepoint >> 10)));
+            wstr.push_back((wchar_t)(0xDC00 + (codepoint & 0x3FF)));
+        }
+        else
+        {
+            wstr.push_back((wchar_t)codepoint);
+        }
+    }
+
+    // append code point to utf8 string
+    static void utf8encode(unsigned long codepoint, std::string& str)
+    {
+        if (codepoint < 0x80)
+        {
+            str.push_back((char)codepoint);
+        }
+        else if (codepoint < 0x800)
+        {
+            str.push_back((char)(0xC0 | (codepoint >> 6)));
+            str.push_back((char)(0x80 | (codepoint & 0x3F)));
+        }
+        else if (codepoint < 0x10000)
+        {
+            str.push_back((char)(0xE0 | (codepoint >> 12)));
+            str.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+            str.push_back((char)(0x80 | (codepoint & 0x3F)));
+        }
+        else
+        {
+            str.push_back((char)(0xF0 | (codepoint >> 18)));
+            str.push_back((char)(0x80 | ((codepoint >> 12) & 0x3F)));
+            str.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+            str.push_back((char)(0x80 | (codepoint & 0x3F)));
+        }
+    }
+
+    // return the end of plain text in string, which can be copied as it is
+    static const char* plain(const char* cur, const char* end)
+    {
+        // short string such as object key is scanned in place
+        const char* limit = end - cur > 16 ? cur + 16 : end;
+
+        while (cur < limit && *cur != '\"' && *cur != '\\' && *cur != '\r' && *cur != '\n' && isasciichar(*cur))
+        {
+            cur++;
+        }
+
+        if (cur == limit && cur < end)
+        {
+            return JsonSimdW::findspecial(cur, end);
+        }
+        return cur;
+    }
+
+    static const wchar_t* plain(const wchar_t* cur, const wchar_t* end)
+    {
+        while (cur < end && *cur != L'\"' && *cur != L'\\' && *cur != L'\r' && *cur != L'\n')
+        {
+            cur++;
+        }
+        return cur;
+    }
+
+    // return the first non-ascii byte in [cur, end), 8 bytes are tested
+    // at a time
+    static const char* ascii(const char* cur, const char* end)
+    {
+        while (end - cur >= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, cur, sizeof(word));
+            if (word & 0x8080808080808080ULL)
+            {
+                break;
+            }
+            cur += 8;
+        }
+
+        while (cur < end && isasciichar(*cur))
+        {
+            cur++;
+        }
+        return cur;
+    }
+
+    // decode one multi-byte utf8 sequence at 'cur' into code point, return
+    // false if the sequence is malformed
+    static bool utf8decode(const char*& cur, const char* end, unsigned long& codepoint)
+    {
+        unsigned char lead = (unsigned char)*cur;
+        int length;
+
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            codepoint = lead & 0x1F;
+            length = 2;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            codepoint = lead & 0x0F;
+            length = 3;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            codepoint = lead & 0x07;
+            length = 4;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (end - cur < length)
+        {
+            return false;
+        }
+
+        for (int i = 1; i < length; i++)
+        {
+            unsigned char trail = (unsigned char)cur[i];
+            if ((trail & 0xC0) != 0x80)
+            {
+                return false;
+            }
+            codepoint = (codepoint << 6) | (trail & 0x3F);
+        }
+
+        // reject overlong form, surrogate and out of range code point
+        if ((length == 3 && codepoint < 0x800) ||
+            (length == 4 && (codepoint < 0x10000 || codepoint > 0x10FFFF)) ||
+            (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+        {
+            return false;
+        }
+
+        cur += length;
+        return true;
+    }
+
+    // skip the white space and check if next non-ws is valid 
+    // beginning character for json token
+    static bool findnext(std::wistream& ins)
+    {
+        wchar_t character;
+        if (!ins.good())
+        {
+            return false;
+        }
+
+        character = ins.peek();
+
+        // return false if no more data to read
+        if (character == std::char_traits<wchar_t>::eof())
+        {
+            return false;
+        }
+
+        // skip white space 
+        while (isskippable(character))
+        {
+            ins.get();
+            character = ins.peek();
+
+            if (character == std::char_traits<wchar_t>::eof())
+            {
+                return false;
+            }
+        }
+
+        // check next character is valid begin character for token 
+        if (character == L'[' || character == L']' ||
+            character == L'{' || character == L'}' ||
+            character == L':' || iswdigit(character) ||
+            character == L',' || character == L'\"' ||
+            character == L'-' || character == L't' ||
+            character == L'f' || character == L'n')
+        {
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    template <typename CharT>
+    static bool findnext(const CharT*& cur, const CharT* end)
+    {
+        // skip white space, return false if no more data to read
+        if (!skip(cur, end))
+        {
+            return false;
+        }
+
+        // check next character is valid begin character for token 
+        CharT character = *cur;
+        if (character == '[' || character == ']' ||
+            character == '{' || character == '}' ||
+            character == ':' || isdigitchar(character) ||
+            character == ',' || character == '\"' ||
+            character == '-' || character == 't' ||
+            character == 'f' || character == 'n')
+        {
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+public:
+    // parse text data from wistream and store tokens in queue
+    static bool parse(std::wistream& ins, std::queue<JsonTokenW>& tokens)
+    {
+        bool success = findnext(ins);
+
+        while (success)
+        {
+            JsonTokenW token(ins);
+
+            if (token.type() == JsonTokenW::Type::Bad)
+            {
+                std::queue<JsonTokenW>().swap(tokens); // clear
+                return false;
+            }
+            else
+            {
+                tokens.push(token);
+            }
+
+            success = findnext(ins);
+        }
+        return true;
+    }
+
+public:
+    //
+    // single pass scanner, JsonW uses them to parse the text directly
+    // without creating tokens. 'cur' is moved to the next character
+    // after the scanned data. CharT is char for utf8 text or wchar_t
+    // for ucs text.
+    //
+
+    // skip the white space, return false if no more data to read
+    template <typename CharT>
+    static bool skip(const CharT*& cur, const CharT* end)
+    {
+        while (cur < end && isskippable(*cur))
+        {
+            cur++;
+        }
+
+        return cur < end;
+    }
+
+    // utf8 text skips long white space in bulk, short white space such
+    // as the indent of compact or lightly indented text is skipped in place
+    static bool skip(const char*& cur, const char* end)
+    {
+        const char* limit = end - cur > 16 ? cur + 16 : end;
+
+        while (cur < limit && isskippable(*cur))
+        {
+            cur++;
+        }
+
+        if (cur == limit && cur < end)
+        {
+            cur = JsonSimdW::skipspace(cur, end);
+        }
+
+        return cur < end;
+    }
+
+    // scan 'true', 'false' or 'null'
+    template <typename CharT>
+    static bool scanliteral(const CharT*& cur, const CharT* end, const char* literal)
+    {
+        const CharT* pos = cur;
+
+        for (; *literal != '\0'; literal++, pos++)
+        {
+            if (pos >= end || *pos != (CharT)*literal)
+            {
+                return false;
+            }
+        }
+
+        cur = pos;
+        return true;
+    }
+
+    // scan a number, return NumberInteger, NumberFloat or Bad
+    template <typename CharT>
+    static Type scannumber(const CharT*& cur, const CharT* end, int_fast64_t& integer, long double& frac)
+    {
+        // the number text is [begin, last) in the buffer
+        const CharT* begin = cur;
+        const CharT* last;
+        bool containdot = false;
+        bool containexp = false;
+        bool negativeexp = false;
+        int64_t exponent = 0;
+
+        // negative value
+        if (cur < end && *cur == '-')
+        {
+            cur++;
+        }
+
+        // if start with 0, it must followed by ., exponent or standalone zero
+        if (cur < end && *cur == '0')
+        {
+            cur++;
+
+            if (cur >= end || (*cur != '.' && *cur != 'e' && *cur != 'E'))
+            {
+                integer = 0;
+                return Type::NumberInteger;
+            }
+
+            if (*cur == '.')
+            {
+                containdot = true;
+                cur++;
+            }
+        }
+
+        while (cur < end && (isdigitchar(*cur) || *cur == '.' || *cur == 'e' || *cur == 'E'))
+        {
+            // handle .
+            if (*cur == '.')
+            {
+                if (containdot || cur == begin)
+                {
+                    return Type::Bad;
+                }
+                else if (cur - begin == 1 && !isdigitchar(*begin))
+                {
+                    return Type::Bad;
+                }
+                else
+                {
+                    containdot = true;
+                }
+            }
+
+            if (*cur == 'e' || *cur == 'E')
+            {
+                containexp = true;
+                break;
+            }
+
+            cur++;
+        }
+
+        last = cur;
+
+        // last character in number text has to be a digit
+        if (last == begin || !isdigitchar(*(last - 1)))
+        {
+            return Type::Bad;
+        }
+
+        // first digit cannot be zero except frac or zero
+        if (!containdot && *begin == '0' && last - begin > 1)
+        {
+            return Type::Bad;
+        }
+
+        // handle exponent notation
+        if (cur < end && (*cur == 'e' || *cur == 'E'))
+        {
+            cur++;
+            if (cur < end && *cur == '-')
+            {
+                negativeexp = true;
+                cur++;
+            }
+
+            if (cur < end && *cur == '+')
+            {
+                cur++;
+            }
+
+            const CharT* expbegin = cur;
+            while (cur < end && isdigitchar(*cur))
+            {
+                exponent = addexponent(exponent, *cur);
+                cur++;
+            }
+
+            if (cur == expbegin)
+            {
+                return Type::Bad;
+            }
+        }
+
+        // digits are converted in place, no temporary string is created
+        return number(begin, last, containdot || containexp,
+            negativeexp ? -exponent : exponent, integer, frac);
+    }
+
+    // scan the utf8 text in [cur, end) that has no quote and escape, such as
+    // the string of MessagePack or CBOR, the text is appended to str. Return
+    // false if utf8 is malformed.
+    template <typename OutT>
+    static bool scanutf8(const char* cur, const char* end, std::basic_string<OutT>& str)
+    {
+        while (cur < end)
+        {
+            const char* run = ascii(cur, end);
+            appendrun(cur, run, str);
+            cur = run;
+
+            if (cur < end && !append(cur, end, str))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // scan a string starts with \", the unescaped text is stored in wstr
+    template <typename CharT, typename OutT>
+    static bool scanstring(const CharT*& cur, const CharT* end, std::basic_string<OutT>& wstr)
+    {
+        // consume \"
+        cur++;
+
+        while (cur < end)
+        {
+            // copy the plain text before next special character in bulk
+            const CharT* run = plain(cur, end);
+            if (run != cur)
+            {
+                appendrun(cur, run, wstr);
+                cur = run;
+
+                if (cur >= end)
+                {
+                    break;
+                }
+            }
+
+            CharT character = *cur;
+
+            if (character == '\\')
+            {
+                cur++;
+                if (cur >= end)
+                {
+                    return false;
+                }
+
+                character = *cur;
+                cur++;
+
+                if (character == 'u')
+                {
+                    // special case for \u, exactly 4 hex digits
+                    unsigned int charvalue = 0;
+
+                    if (end - cur < 4 || !hex4(cur, charvalue))
+                    {
+                        return false;
+                    }
+                    cur += 4;
+
+                    appendescape(charvalue, cur, end, wstr);
+                    continue;
+                }
+
+                // other single character cases
+                switch (character)
+                {
+                case '\"': wstr.push_back((OutT)'\"'); break;
+                case '\\': wstr.push_back((OutT)'\\'); break;
+                case '/': wstr.push_back((OutT)'/'); break;
+                case 'b':  wstr.push_back((OutT)0x08); break;
+                case 'f':  wstr.push_back((OutT)0x0c); break;
+                case 'n':  wstr.push_back((OutT)'\n'); break;
+                case 'r':  wstr.push_back((OutT)'\r'); break;
+                case 't':  wstr.push_back((OutT)'\t'); break;
+                default:
+                    // unknown escape is dropped, including multi-byte character
+                    if (!isasciichar(character))
+                    {
+                        std::basic_string<OutT> dropped;
+                        cur--;
+                        if (!append(cur, end, dropped))
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+            else if (character == '\r' || character == '\n')
+            {
+                // unexpected EOL
+                return false;
+            }
+            else if (character == '\"')
+            {
+                cur++;
+                return true;
+            }
+            else if (isasciichar(character))
+            {
+                wstr.push_back((OutT)character);
+                cur++;
+            }
+            else if (!append(cur, end, wstr))
+            {
+                // malformed utf8 sequence
+                return false;
+            }
+        }
+
+        // unexpected EOF
+        return false;
+    }
+
+    // scan the remaining tokens after json value, return false if any of
+    // them is malformed. Data after a character that cannot begin a token
+    // is ignored, which is the same behavior as parse().
+    template <typename CharT>
+    static bool scantail(const CharT*& cur, const CharT* end)
+    {
+        int_fast64_t integer;
+        long double frac;
+        std::wstring wstr;
+
+        while (findnext(cur, end))
+        {
+            switch (*cur)
+            {
+            case '{': case '}': case '[': case ']': case ':': case ',':
+                cur++;
+                break;
+            case 't':
+                if (!scanliteral(cur, end, "true")) return false;
+                break;
+            case 'f':
+                if (!scanliteral(cur, end, "false")) return false;
+                break;
+            case 'n':
+                if (!scanliteral(cur, end, "null")) return false;
+                break;
+            case '\"':
+                wstr.clear();
+                if (!scanstring(cur, end, wstr)) return false;
+                break;
+            default:
+                if (scannumber(cur, end, integer, frac) == Type::Bad) return false;
+                break;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    enum Type type_ = Type::Bad;
+    int_fast64_t integer_ = 0;
+    long double frac_ = 0.0;
+    std::wstring wstring_;
+    bool boolean_ = true;
+};
+
+// JsonArenaW is a bump allocator that hands out memory from large blocks
+// and releases them all together. JsonDocumentW uses it to keep every node
+// of a parsed document in contiguous memory. Individual deallocation only
+// updates the live counter, the memory is reused after reset(). It is not
+// thread safe, one arena belongs to one document.
+class JsonArenaW
+{
+public:
+    const static size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+public:
+    explicit JsonArenaW(size_t blocksize = DEFAULT_BLOCK_SIZE)
+        : blocksize_(blocksize > 0 ? blocksize : DEFAULT_BLOCK_SIZE)
+    {
+    }
+
+    ~JsonArenaW()
+    {
+        for (auto& block : blocks_)
+        {
+            delete[] block.data;
+        }
+    }
+
+    JsonArenaW(const JsonArenaW&) = delete;
+    JsonArenaW& operator=(const JsonArenaW&) = delete;
+
+public:
+    // return 'size' bytes aligned to 'align', which must be power of 2
+    void* allocate(size_t size, size_t align)
+    {
+        while (current_ < blocks_.size())
+        {
+            Block& block = blocks_[current_];
+            size_t address = (size_t)(block.data + offset_);
+            size_t padding = (align - (address & (align - 1))) & (align - 1);
+
+            if (offset_ + padding + size <= block.size)
+            {
+                char* ptr = block.data + offset_ + padding;
+                offset_ += padding + size;
+                used_ += size;
+                live_++;
+                return ptr;
+            }
+
+            // the rest of this block is wasted, move to next one
+            current_++;
+            offset_ = 0;
+        }
+
+        // large request gets a block of its own
+        Block block;
+        block.size = std::max(blocksize_, size + align);
+        block.data = new char[block.size];
+        blocks_.push_back(block);
+        capacity_ += block.size;
+
+        return allocate(size, align);
+    }
+
+    // memory is not returned to the system until reset() or destruction
+    void deallocate(void* ptr, size_t)
+    {
+        if (ptr != nullptr)
+        {
+            live_--;
+        }
+    }
+
+    // reuse all blocks for next document, return false and do nothing if
+    // there is still allocation alive
+    bool reset()
+    {
+        if (live_ != 0)
+        {
+            return false;
+        }
+
+        current_ = 0;
+        offset_ = 0;
+        used_ = 0;
+        return true;
+    }
+
+    // number of allocations that are not deallocated yet
+    size_t live() const { return live_; }
+
+    // bytes handed out since last reset
+    size_t used() const { return used_; }
+
+    // bytes reserved from the system
+    size_t capacity() const { return capacity_; }
+
+private:
+    struct Block
+    {
+        char* data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    size_t blocksize_;
+    size_t current_ = 0;
+    size_t offset_ = 0;
+    size_t used_ = 0;
+    size_t live_ = 0;
+    size_t capacity_ = 0;
+};
+
+// JsonArenaAllocatorW is the standard allocator interface of JsonArenaW,
+// it is used by std::allocate_shared so the node and its reference counter
+// are placed in the arena. Every copy of the allocator shares the arena,
+// so the arena lives until the last node allocated from it is released.
+template <typename T>
+class JsonArenaAllocatorW
+{
+public:
+    typedef T value_type;
+
+    explicit JsonArenaAllocatorW(const std::shared_ptr<JsonArenaW>& arena) : arena_(arena)
+    {
+    }
+
+    template <typename U>
+    JsonArenaAllocatorW(const JsonArenaAllocatorW<U>& rhs) : arena_(rhs.arena())
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        arena_->deallocate(ptr, n * sizeof(T));
+    }
+
+    const std::shared_ptr<JsonArenaW>& arena() const { return arena_; }
+
+    template <typename U>
+    bool operator==(const JsonArenaAllocatorW<U>& rhs) const { return arena_ == rhs.arena(); }
+
+    template <typename U>
+    bool operator!=(const JsonArenaAllocatorW<U>& rhs) const { return arena_ != rhs.arena(); }
+
+private:
+    std::shared_ptr<JsonArenaW> arena_;
+};
+
+// JsonFileW gives the content of a file as one read-only block of memory.
+// The file is memory mapped if OCTILLION_JSONW_MMAP is defined, so parser
+// reads it in place without copying it. Otherwise, or if mapping fails,
+// the file is read into a buffer in one pass.
+class JsonFileW
+{
+public:
+    explicit JsonFileW(const std::string& path)
+    {
+#if defined(OCTILLION_JSONW_MMAP)
+        if (map(path))
+        {
+            return;
+        }
+#endif
+        std::ifstream fin(path, std::ios::binary);
+        good_ = read(fin, buffer_);
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+
+    ~JsonFileW()
+    {
+#if defined(OCTILLION_JSONW_MMAP)
+        if (mapping_ != nullptr)
+        {
+            ::munmap(mapping_, size_);
+        }
+#endif
+    }
+
+    JsonFileW(const JsonFileW&) = delete;
+    JsonFileW& operator=(const JsonFileW&) = delete;
+
+public:
+    // false if file cannot be opened or read
+    bool good() const { return good_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // read the rest of 'fin' into 'buffer', the size is queried first if
+    // the stream is seekable so the buffer is allocated once
+    static bool read(std::ifstream& fin, std::string& buffer)
+    {
+        if (!fin.good())
+        {
+            return false;
+        }
+
+        std::streampos begin = fin.tellg();
+        std::streamoff size = -1;
+
+        if (begin != std::streampos(-1) && fin.seekg(0, std::ios::end))
+        {
+            size = fin.tellg() - begin;
+            fin.seekg(begin);
+        }
+
+        // size of directory or device is not the size of its content
+        if (size >= 0 && (unsigned long long)size < buffer.max_size())
+        {
+            buffer.resize((size_t)size);
+            fin.read(&buffer[0], size);
+            buffer.resize((size_t)fin.gcount());
+            return !fin.bad();
+        }
+
+        fin.clear();
+        try
+        {
+            buffer.assign(
+                (std::istreambuf_iterator<char>(fin)),
+                (std::istreambuf_iterator<char>()));
+        }
+        catch (const std::ios_base::failure&)
+        {
+            // such as reading a directory
+            return false;
+        }
+        return !fin.bad();
+    }
+
+private:
+#if defined(OCTILLION_JSONW_MMAP)
+    // return false if the file should be read instead
+    bool map(const std::string& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat status;
+        if (::fstat(fd, &status) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        else if (S_ISDIR(status.st_mode))
+        {
+            ::close(fd);
+            return true;
+        }
+        else if (!S_ISREG(status.st_mode))
+        {
+            // pipe or device is read as stream
+            ::close(fd);
+            return false;
+        }
+
+        size_ = (size_t)status.st_size;
+        if (size_ == 0)
+        {
+            // empty file cannot be mapped
+            ::close(fd);
+            good_ = true;
+            return true;
+        }
+
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (mapping == MAP_FAILED)
+        {
+            size_ = 0;
+            return false;
+        }
+
+        // parser reads the file once from begin to end
+        ::madvise(mapping, size_, MADV_SEQUENTIAL);
+
+        mapping_ = mapping;
+        data_ = static_cast<const char*>(mapping);
+        good_ = true;
+        return true;
+    }
+#endif
+
+private:
+    bool good_ = false;
+    const char* data_ = "";
+    size_t size_ = 0;
+    void* mapping_ = nullptr;
+    std::string buffer_;
+};
+
+// JsonKeyW is the immutable key of json object member. The text is kept in
+// one reference counted block together with its FNV-1a hash, so copying a
+// key never copies the text. Keys created by JsonKeyPoolW share the block
+// of the same text, and two keys of the same block are equal without
+// comparing the text.
+template <typename CharT>
+class JsonKeyW
+{
+public:
+    typedef std::basic_string<CharT> String;
+
+public:
+    JsonKeyW() : block_(nullptr)
+    {
+    }
+
+    JsonKeyW(const CharT* text, size_t length) : block_(create(text, length))
+    {
+    }
+
+    JsonKeyW(const String& text) : block_(create(text.data(), text.length()))
+    {
+    }
+
+    JsonKeyW(const JsonKeyW& rhs) : block_(rhs.block_)
+    {
+        if (block_ != nullptr)
+        {
+            block_->references++;
+        }
+    }
+
+    JsonKeyW(JsonKeyW&& rhs) : block_(rhs.block_)
+    {
+        rhs.block_ = nullptr;
+    }
+
+    ~JsonKeyW()
+    {
+        release();
+    }
+
+    JsonKeyW& operator=(JsonKeyW rhs)
+    {
+        std::swap(block_, rhs.block_);
+        return *this;
+    }
+
+    const CharT* data() const { return block_ == nullptr ? nullptr : block_->text(); }
+    size_t length() const { return block_ == nullptr ? 0 : block_->length; }
+    uint32_t hash() const { return block_ == nullptr ? hash(nullptr, 0) : block_->hash; }
+    String str() const { return String(data(), length()); }
+
+    // true if both keys share the same text block
+    bool same(const JsonKeyW& rhs) const { return block_ == rhs.block_; }
+
+    // FNV-1a of the code units of text
+    static uint32_t hash(const CharT* text, size_t length)
+    {
+        typedef typename std::make_unsigned<CharT>::type Unit;
+        uint32_t value = 2166136261U;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            value ^= (uint32_t)(Unit)text[i];
+            value *= 16777619U;
+        }
+
+        return value;
+    }
+
+    // same as hash() and evaluated at compile time for literal text
+    static constexpr uint32_t literal(const CharT* text, size_t length, uint32_t value = 2166136261U)
+    {
+        return length == 0 ? value : literal(text + 1, length - 1,
+            (value ^ (uint32_t)(typename std::make_unsigned<CharT>::type)*text) * 16777619U);
+    }
+
+    int compare(const CharT* text, size_t length) const
+    {
+        size_t size = this->length();
+        int result = std::char_traits<CharT>::compare(data(), text, std::min(size, length));
+
+        if (result != 0)
+        {
+            return result;
+        }
+
+        return size < length ? -1 : (size > length ? 1 : 0);
+    }
+
+    friend bool operator==(const JsonKeyW& lhs, const JsonKeyW& rhs)
+    {
+        return lhs.same(rhs) ||
+            (lhs.hash() == rhs.hash() && lhs.compare(rhs.data(), rhs.length()) == 0);
+    }
+
+    friend bool operator==(const JsonKeyW& lhs, const String& rhs) { return lhs.compare(rhs.data(), rhs.length()) == 0; }
+    friend bool operator==(const String& lhs, const JsonKeyW& rhs) { return rhs.compare(lhs.data(), lhs.length()) == 0; }
+    friend bool operator<(const JsonKeyW& lhs, const JsonKeyW& rhs) { return lhs.compare(rhs.data(), rhs.length()) < 0; }
+    friend bool operator<(const JsonKeyW& lhs, const String& rhs) { return lhs.compare(rhs.data(), rhs.length()) < 0; }
+    friend bool operator<(const String& lhs, const JsonKeyW& rhs) { return rhs.compare(lhs.data(), lhs.length()) > 0; }
+
+private:
+    // 12 bytes header, short key fits in one 32 bytes heap chunk
+    struct Block
+    {
+        std::atomic<uint32_t> references;
+        uint32_t length;
+        uint32_t hash;
+
+        // text follows the block
+        CharT* text() { return reinterpret_cast<CharT*>(this + 1); }
+    };
+
+    static Block* create(const CharT* text, size_t length)
+    {
+        void* memory = ::operator new(sizeof(Block) + (length + 1) * sizeof(CharT));
+        Block* block = new (memory) Block();
+
+        block->references = 1;
+        block->length = (uint32_t)length;
+        block->hash = hash(text, length);
+        std::char_traits<CharT>::copy(block->text(), text, length);
+        block->text()[length] = 0;
+
+        return block;
+    }
+
+    void release()
+    {
+        if (block_ != nullptr && --block_->references == 0)
+        {
+            block_->~Block();
+            ::operator delete(block_);
+        }
+        block_ = nullptr;
+    }
+
+private:
+    Block* block_;
+};
+
+// JsonKeyLiteralW is a key known at compile time, created by "id"_jk or
+// L"id"_jk. Its FNV-1a hash is computed by the compiler, so looking it up
+// in a json object hashes and converts nothing. The key is compared with
+// the keys of JsonW and JsonU8 unit by unit, which needs no conversion if
+// the literal is ascii or in the key encoding. Declare it constexpr to be
+// sure the hash is computed at compile time, and use hash() as the case
+// label of a switch on JsonKeyW::hash().
+template <typename CharT>
+class JsonKeyLiteralW
+{
+public:
+    constexpr JsonKeyLiteralW(const CharT* text, size_t length)
+        : text_(text), length_(length), hash_(JsonKeyW<CharT>::literal(text, length)),
+          ascii_(plain(text, length))
+    {
+    }
+
+    constexpr const CharT* data() const { return text_; }
+    constexpr size_t length() const { return length_; }
+    constexpr uint32_t hash() const { return hash_; }
+    constexpr bool ascii() const { return ascii_; }
+    std::basic_string<CharT> str() const { return std::basic_string<CharT>(text_, length_); }
+
+    // true if the key can be compared with the keys of KeyT as it is
+    template <typename KeyT>
+    constexpr bool comparable() const
+    {
+        return std::is_same<KeyT, CharT>::value || ascii_;
+    }
+
+    // compare code units of 'text' with the literal, same order as
+    // JsonKeyW::compare()
+    template <typename KeyT>
+    int compare(const KeyT* text, size_t length) const
+    {
+        typedef typename std::make_unsigned<KeyT>::type Unit;
+        typedef typename std::make_unsigned<CharT>::type Own;
+        size_t size = std::min(length, length_);
+
+        for (size_t i = 0; i < size; i++)
+        {
+            uint32_t lhs = (uint32_t)(Unit)text[i];
+            uint32_t rhs = (uint32_t)(Own)text_[i];
+
+            if (lhs != rhs)
+            {
+                return lhs < rhs ? -1 : 1;
+            }
+        }
+
+        return length < length_ ? -1 : (length > length_ ? 1 : 0);
+    }
+
+    template <typename KeyT>
+    friend bool operator==(const JsonKeyW<KeyT>& lhs, const JsonKeyLiteralW& rhs)
+    {
+        return lhs.hash() == rhs.hash() && rhs.compare(lhs.data(), lhs.length()) == 0;
+    }
+
+    template <typename KeyT>
+    friend bool operator==(const JsonKeyLiteralW& lhs, const JsonKeyW<KeyT>& rhs)
+    {
+        return rhs == lhs;
+    }
+
+    template <typename KeyT>
+    friend bool operator!=(const JsonKeyW<KeyT>& lhs, const JsonKeyLiteralW& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <typename KeyT>
+    friend bool operator<(const JsonKeyW<KeyT>& lhs, const JsonKeyLiteralW& rhs)
+    {
+        return rhs.compare(lhs.data(), lhs.length()) < 0;
+    }
+
+private:
+    static constexpr bool plain(const CharT* text, size_t length)
+    {
+        return length == 0 || ((uint32_t)(typename std::make_unsigned<CharT>::type)*text < 0x80 &&
+            plain(text + 1, length - 1));
+    }
+
+private:
+    const CharT* text_;
+    size_t length_;
+    uint32_t hash_;
+    bool ascii_;
+};
+
+constexpr JsonKeyLiteralW<char> operator"" _jk(const char* text, size_t length)
+{
+    return JsonKeyLiteralW<char>(text, length);
+}
+
+constexpr JsonKeyLiteralW<wchar_t> operator"" _jk(const wchar_t* text, size_t length)
+{
+    return JsonKeyLiteralW<wchar_t>(text, length);
+}
+
+class JsonKeyPoolW;
+
+// JsonOptionsW controls how BasicJsonW parses json text. Object layout
+// is one of:
+// SORTED  - members are kept sorted by key in a flat vector, text is
+//           formatted in key order. This is the default.
+// ORDERED - members are kept in insertion order with an open addressing
+//           hash index, text is formatted in the order of json source.
+// Define OCTILLION_JSONW_ORDERED_OBJECT to make ORDERED the default.
+// Top-level array of text larger than PARALLEL_SIZE is parsed by 'threads'
+// threads, elements are grouped into chunks of PARALLEL_CHUNK bytes.
+struct JsonOptionsW
+{
+    const static int SORTED = 0;
+    const static int ORDERED = 1;
+#if defined(OCTILLION_JSONW_ORDERED_OBJECT)
+    const static int DEFAULT_OBJECT = ORDERED;
+#else
+    const static int DEFAULT_OBJECT = SORTED;
+#endif
+
+    const static size_t PARALLEL_SIZE = 1024 * 1024;
+    const static size_t PARALLEL_CHUNK = 64 * 1024;
+
+    // nodes are allocated from arena if it is not null
+    std::shared_ptr<JsonArenaW> arena;
+
+    // object keys are interned in pool if it is not null
+    std::shared_ptr<JsonKeyPoolW> keys;
+
+    // layout of json object container
+    int objects = DEFAULT_OBJECT;
+
+    // threads to parse large top-level array, 0 is one thread per cpu core
+    size_t threads = 1;
+
+    // objects and arrays below the top-level value are parsed on first
+    // access, see README.md
+    bool lazy = false;
+};
+
+// JsonObjectW is the container of json object members, it is a flat vector
+// of key-value pairs with the layout given by JsonOptionsW. SORTED layout
+// uses binary search. ORDERED layout scans small object linearly and builds
+// a hash index once it has more than LINEAR_LIMIT members. Key is JsonKeyW,
+// members can be looked up by JsonKeyW or by its String.
+// Members added to SORTED layout out of key order are appended to an
+// unsorted tail, which is hash indexed like ORDERED layout and merged once
+// it is longer than the sorted members. Erased member is only marked until
+// half of the members are erased. begin() merges the tail and drops the
+// erased members, so take begin() before end() when iterating. begin() of
+// a const object lists them in the same order without changing it.
+template <typename Key, typename Value>
+class JsonObjectW
+{
+public:
+    typedef std::pair<Key, Value> Member;
+    typedef typename std::vector<Member>::iterator iterator;
+
+    const static size_t LINEAR_LIMIT = 8;
+
+    // iterator of a const object, it skips the erased members and visits
+    // the unsorted tail of SORTED layout in key order. The iterator from
+    // find() only points to the member.
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Member value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Member* pointer;
+        typedef const Member& reference;
+
+        const_iterator() = default;
+
+        reference operator*() const { return *member_; }
+        pointer operator->() const { return member_; }
+
+        const_iterator& operator++()
+        {
+            if (order_)
+            {
+                at_++;
+                member_ = at_ < order_->size() ? first_ + (*order_)[at_] : last_;
+            }
+            else
+            {
+                member_++;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator it = *this;
+            ++(*this);
+            return it;
+        }
+
+        bool operator==(const const_iterator& rhs) const { return member_ == rhs.member_; }
+        bool operator!=(const const_iterator& rhs) const { return member_ != rhs.member_; }
+
+    private:
+        friend class JsonObjectW;
+
+        explicit const_iterator(const Member* member) : member_(member)
+        {
+        }
+
+        const Member* member_ = nullptr;
+
+        // positions of the members in listing order, null if it is the
+        // order of the vector
+        std::shared_ptr<const std::vector<uint32_t>> order_;
+        const Member* first_ = nullptr;
+        const Member* last_ = nullptr;
+        size_t at_ = 0;
+    };
+
+public:
+    explicit JsonObjectW(int layout = JsonOptionsW::DEFAULT_OBJECT) : layout_(layout)
+    {
+    }
+
+    int layout() const { return layout_; }
+    size_t size() const { return members_.size() - erased_count_; }
+    bool empty() const { return size() == 0; }
+
+    iterator begin() { settle(); return members_.begin(); }
+    iterator end() { return members_.end(); }
+    const_iterator begin() const
+    {
+        const Member* first = members_.data();
+        bool merged = layout_ != JsonOptionsW::SORTED || sorted_ == members_.size();
+        if (merged && erased_count_ == 0)
+        {
+            return const_iterator(first);
+        }
+
+        // listing order of the members that are not erased, the unsorted
+        // tail is sorted and merged into the sorted members
+        std::shared_ptr<std::vector<uint32_t>> order = std::make_shared<std::vector<uint32_t>>();
+        order->reserve(size());
+        for (size_t i = 0; i < members_.size(); i++)
+        {
+            if (!erased(i))
+            {
+                order->push_back((uint32_t)i);
+            }
+        }
+
+        if (!merged)
+        {
+            auto less = [first](uint32_t lhs, uint32_t rhs) { return first[lhs].first < first[rhs].first; };
+            auto tail = std::lower_bound(order->begin(), order->end(), (uint32_t)sorted_);
+            std::sort(tail, order->end(), less);
+            std::inplace_merge(order->begin(), tail, order->end(), less);
+        }
+
+        const_iterator it(order->empty() ? first + members_.size() : first + order->front());
+        it.order_ = std::move(order);
+        it.first_ = first;
+        it.last_ = first + members_.size();
+        return it;
+    }
+
+    const_iterator end() const { return const_iterator(members_.data() + members_.size()); }
+
+    template <typename K>
+    iterator find(const K& key)
+    {
+        return members_.begin() + position(key);
+    }
+
+    template <typename K>
+    const_iterator find(const K& key) const
+    {
+        return const_iterator(members_.data() + position(key));
+    }
+
+    template <typename K>
+    size_t count(const K& key) const
+    {
+        return position(key) < members_.size() ? 1 : 0;
+    }
+
+    // insert the member if the key does not exist, return the member with
+    // the key and whether it is inserted
+    std::pair<iterator, bool> insert(Member member)
+    {
+        if (layout_ == JsonOptionsW::SORTED)
+        {
+            // json text with sorted keys is appended directly
+            if (sorted_ == members_.size() && (members_.empty() || members_.back().first < member.first))
+            {
+                push(std::move(member));
+                sorted_++;
+                return std::make_pair(members_.end() - 1, true);
+            }
+
+            size_t found = locate(member.first);
+            if (found < members_.size())
+            {
+                if (!erased(found))
+                {
+                    return std::make_pair(members_.begin() + found, false);
+                }
+
+                // erased member keeps its key and its place in the order
+                erased_[found] = false;
+                erased_count_--;
+                members_[found].second = std::move(member.second);
+                return std::make_pair(members_.begin() + found, true);
+            }
+
+            push(std::move(member));
+
+            if (members_.size() - sorted_ > LINEAR_LIMIT && members_.size() > 2 * sorted_)
+            {
+                Key key = members_.back().first;
+                merge();
+                return std::make_pair(members_.begin() + position(key), true);
+            }
+
+            index(members_.size() - 1);
+            return std::make_pair(members_.end() - 1, true);
+        }
+
+        size_t found = position(member.first);
+        if (found < members_.size())
+        {
+            return std::make_pair(members_.begin() + found, false);
+        }
+
+        push(std::move(member));
+        index(members_.size() - 1);
+        return std::make_pair(members_.end() - 1, true);
+    }
+
+    // append the member without looking up the key, used by parser to load
+    // all members of an object before finish() sorts or indexes them
+    void append(Member member)
+    {
+        push(std::move(member));
+    }
+
+    // sort or index the appended members, return false if key is duplicated
+    bool finish()
+    {
+        if (layout_ == JsonOptionsW::SORTED)
+        {
+            auto less = [](const Member& lhs, const Member& rhs) { return lhs.first < rhs.first; };
+            if (!std::is_sorted(members_.begin(), members_.end(), less))
+            {
+                std::sort(members_.begin(), members_.end(), less);
+            }
+            sorted_ = members_.size();
+
+            for (size_t i = 1; i < members_.size(); i++)
+            {
+                if (members_[i - 1].first == members_[i].first)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        if (members_.size() > LINEAR_LIMIT)
+        {
+            return rehash(4 * LINEAR_LIMIT);
+        }
+
+        for (size_t i = 1; i < members_.size(); i++)
+        {
+            for (size_t j = 0; j < i; j++)
+            {
+                if (members_[j].first == members_[i].first)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename K>
+    Value& operator[](const K& key)
+    {
+        return insert(Member(Key(key), Value())).first->second;
+    }
+
+    // mark the member erased and return the next member, the vector is
+    // compacted once half of it is erased
+    iterator erase(iterator it)
+    {
+        size_t offset = it - members_.begin();
+
+        if (erased_.empty())
+        {
+            erased_.assign(members_.size(), false);
+        }
+
+        erased_[offset] = true;
+        erased_count_++;
+
+        // erased member of SORTED layout is still found by its key
+        if (!slots_.empty() && layout_ == JsonOptionsW::ORDERED)
+        {
+            unplace(offset);
+        }
+
+        // key is kept for the lookup of SORTED layout, value is released
+        it->second = Value();
+
+        offset++;
+        if (2 * erased_count_ > members_.size())
+        {
+            offset = compact(offset);
+        }
+
+        return members_.begin() + offset;
+    }
+
+    void reserve(size_t size)
+    {
+        members_.reserve(size);
+    }
+
+private:
+    struct Slot
+    {
+        uint32_t position; // member position + 1, 0 is empty slot
+        uint32_t hash;
+    };
+
+    // key keeps its hash, String is hashed on lookup
+    static uint32_t hash(const Key& key)
+    {
+        return key.hash();
+    }
+
+    template <typename K>
+    static uint32_t hash(const K& key)
+    {
+        return Key::hash(key.data(), key.length());
+    }
+
+    // key literal keeps the hash computed at compile time
+    template <typename CharT>
+    static uint32_t hash(const JsonKeyLiteralW<CharT>& key)
+    {
+        return key.hash();
+    }
+
+    bool erased(size_t position) const
+    {
+        return !erased_.empty() && erased_[position];
+    }
+
+    void push(Member member)
+    {
+        members_.push_back(std::move(member));
+        if (!erased_.empty())
+        {
+            erased_.push_back(false);
+        }
+    }
+
+    // position of key in SORTED layout including erased member, size() if
+    // not found
+    template <typename K>
+    size_t locate(const K& key) const
+    {
+        typename std::vector<Member>::const_iterator last = members_.begin() + sorted_;
+        typename std::vector<Member>::const_iterator it = std::lower_bound(members_.begin(), last, key,
+            [](const Member& member, const K& key) { return member.first < key; });
+        if (it != last && it->first == key)
+        {
+            return it - members_.begin();
+        }
+
+        return probe(key);
+    }
+
+    // position of key, size() if not found
+    template <typename K>
+    size_t position(const K& key) const
+    {
+        if (layout_ == JsonOptionsW::SORTED)
+        {
+            size_t found = locate(key);
+            if (found < members_.size() && erased(found))
+            {
+                return members_.size();
+            }
+            return found;
+        }
+
+        return probe(key);
+    }
+
+    // position of key in the members after the sorted ones, scanned
+    // linearly or looked up in hash index, size() if not found
+    template <typename K>
+    size_t probe(const K& key) const
+    {
+        if (slots_.empty())
+        {
+            for (size_t i = sorted(); i < members_.size(); i++)
+            {
+                if (members_[i].first == key && !(erased(i) && layout_ == JsonOptionsW::ORDERED))
+                {
+                    return i;
+                }
+            }
+            return members_.size();
+        }
+
+        uint32_t code = hash(key);
+        size_t mask = slots_.size() - 1;
+
+        for (size_t i = code & mask; slots_[i].position != 0; i = (i + 1) & mask)
+        {
+            if (slots_[i].hash == code && members_[slots_[i].position - 1].first == key)
+            {
+                return slots_[i].position - 1;
+            }
+        }
+
+        return members_.size();
+    }
+
+    // merge the unsorted tail and drop the erased members
+    void settle()
+    {
+        if (layout_ == JsonOptionsW::SORTED && sorted_ < members_.size())
+        {
+            merge();
+        }
+        else if (erased_count_ > 0)
+        {
+            compact(0);
+        }
+    }
+
+    void merge()
+    {
+        if (erased_count_ > 0)
+        {
+            compact(0);
+        }
+
+        auto less = [](const Member& lhs, const Member& rhs) { return lhs.first < rhs.first; };
+        std::sort(members_.begin() + sorted_, members_.end(), less);
+        std::inplace_merge(members_.begin(), members_.begin() + sorted_, members_.end(), less);
+        sorted_ = members_.size();
+        slots_.clear();
+    }
+
+    // members before this position are sorted and not hash indexed
+    size_t sorted() const
+    {
+        return layout_ == JsonOptionsW::SORTED ? sorted_ : 0;
+    }
+
+    // remove the erased members, return the new position of the member at
+    // 'offset'
+    size_t compact(size_t offset)
+    {
+        size_t live = 0, sorted = 0, moved = offset;
+
+        for (size_t i = 0; i < members_.size(); i++)
+        {
+            if (erased_[i])
+            {
+                moved -= i < offset ? 1 : 0;
+                continue;
+            }
+
+            sorted += i < sorted_ ? 1 : 0;
+            if (live != i)
+            {
+                members_[live] = std::move(members_[i]);
+            }
+            live++;
+        }
+
+        members_.erase(members_.begin() + live, members_.end());
+        erased_.clear();
+        erased_count_ = 0;
+        sorted_ = sorted;
+
+        if (!slots_.empty())
+        {
+            rehash(slots_.size());
+        }
+        return moved;
+    }
+
+    // add the member at 'position' into hash index, the table is kept at
+    // most half full
+    void index(size_t position)
+    {
+        if (slots_.empty())
+        {
+            if (members_.size() - sorted() > LINEAR_LIMIT)
+            {
+                rehash(4 * LINEAR_LIMIT);
+            }
+            return;
+        }
+
+        if (2 * (members_.size() - sorted()) > slots_.size())
+        {
+            rehash(2 * slots_.size());
+            return;
+        }
+
+        place(position, members_[position].first.hash());
+    }
+
+    // return false if the key of 'position' is already in the index
+    bool place(size_t position, uint32_t code)
+    {
+        size_t mask = slots_.size() - 1;
+        size_t i = code & mask;
+
+        while (slots_[i].position != 0)
+        {
+            if (slots_[i].hash == code && members_[slots_[i].position - 1].first == members_[position].first)
+            {
+                return false;
+            }
+            i = (i + 1) & mask;
+        }
+
+        slots_[i].position = (uint32_t)(position + 1);
+        slots_[i].hash = code;
+        return true;
+    }
+
+    // remove the member at 'position' from hash index, the slots after it
+    // are shifted back so no lookup stops at the emptied slot
+    void unplace(size_t position)
+    {
+        size_t mask = slots_.size() - 1;
+        size_t hole = members_[position].first.hash() & mask;
+
+        while (slots_[hole].position != position + 1)
+        {
+            hole = (hole + 1) & mask;
+        }
+
+        for (size_t i = (hole + 1) & mask; slots_[i].position != 0; i = (i + 1) & mask)
+        {
+            // slot can move back if the hole is between its home and itself
+            size_t home = slots_[i].hash & mask;
+            if (((i - home) & mask) >= ((i - hole) & mask))
+            {
+                slots_[hole] = slots_[i];
+                hole = i;
+            }
+        }
+
+        slots_[hole].position = 0;
+        slots_[hole].hash = 0;
+    }
+
+    bool rehash(size_t size)
+    {
+        while (size < 2 * (members_.size() - sorted()))
+        {
+            size *= 2;
+        }
+
+        Slot empty = { 0, 0 };
+        slots_.assign(size, empty);
+
+        bool unique = true;
+        for (size_t i = sorted(); i < members_.size(); i++)
+        {
+            if (!(erased(i) && layout_ == JsonOptionsW::ORDERED))
+            {
+                unique = place(i, members_[i].first.hash()) && unique;
+            }
+        }
+        return unique;
+    }
+
+private:
+    int layout_;
+    std::vector<Member> members_;
+    std::vector<Slot> slots_;
+
+    // members_[0, sorted_) is sorted by key in SORTED layout
+    size_t sorted_ = 0;
+
+    // erased mark of each member, empty if none is erased
+    std::vector<bool> erased_;
+    size_t erased_count_ = 0;
+};
+
+// JsonKeyPoolW interns the keys of json object. Objects parsed with the same
+// pool share one JsonKeyW for each distinct key, which saves the memory of
+// repeated keys in record shaped json. The pool keeps at most 'capacity'
+// keys of each character type, keys beyond that are not interned. The pool
+// is not thread safe, use one pool per thread.
+class JsonKeyPoolW
+{
+public:
+    const static size_t DEFAULT_CAPACITY = 4096;
+
+public:
+    explicit JsonKeyPoolW(size_t capacity = DEFAULT_CAPACITY)
+        : capacity_(capacity), wkeys_(JsonOptionsW::ORDERED), keys_(JsonOptionsW::ORDERED)
+    {
+    }
+
+    // return the interned key of text
+    template <typename CharT>
+    JsonKeyW<CharT> intern(const std::basic_string<CharT>& text)
+    {
+        JsonObjectW<JsonKeyW<CharT>, bool>& table = keys(CharT());
+
+        auto it = table.find(text);
+        if (it != table.end())
+        {
+            return it->first;
+        }
+
+        JsonKeyW<CharT> key(text);
+        if (table.size() < capacity_)
+        {
+            table.insert(std::make_pair(key, true));
+        }
+
+        return key;
+    }
+
+    // number of interned keys
+    size_t size() const { return wkeys_.size() + keys_.size(); }
+
+    // release all interned keys, the keys still in use are not affected
+    void clear()
+    {
+        wkeys_ = JsonObjectW<JsonKeyW<wchar_t>, bool>(JsonOptionsW::ORDERED);
+        keys_ = JsonObjectW<JsonKeyW<char>, bool>(JsonOptionsW::ORDERED);
+    }
+
+private:
+    JsonObjectW<JsonKeyW<wchar_t>, bool>& keys(wchar_t) { return wkeys_; }
+    JsonObjectW<JsonKeyW<char>, bool>& keys(char) { return keys_; }
+
+private:
+    size_t capacity_;
+    JsonObjectW<JsonKeyW<wchar_t>, bool> wkeys_;
+    JsonObjectW<JsonKeyW<char>, bool> keys_;
+};
+
+// JsonTraitsW converts between the character type stored in BasicJsonW
+// and the utf8 (std::string) / ucs (std::wstring) interface.
+template <typename CharT>
+struct JsonTraitsW;
+
+template <>
+struct JsonTraitsW<wchar_t>
+{
+    static const std::wstring& wide(const std::wstring& wstr) { return wstr; }
+    static std::wstring wide(std::wstring&& wstr) { return std::move(wstr); }
+    static const std::wstring& native(const std::wstring& wstr) { return wstr; }
+    static std::wstring native(std::wstring&& wstr) { return std::move(wstr); }
+    static std::wstring native(const wchar_t* wstr) { return std::wstring(wstr); }
+    static std::wstring native(const wchar_t* wstr, size_t length) { return std::wstring(wstr, length); }
+
+    static std::string utf8(const std::wstring& wstr)
+    {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
+        return conv.to_bytes(wstr);
+    }
+
+    static std::wstring native(const std::string& str)
+    {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
+        return conv.from_bytes(str);
+    }
+
+    static std::wstring native(const char* str)
+    {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
+        return conv.from_bytes(str);
+    }
+
+    static std::wstring native(const char* str, size_t length)
+    {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
+        return conv.from_bytes(str, str + length);
+    }
+};
+
+template <>
+struct JsonTraitsW<char>
+{
+    static const std::string& utf8(const std::string& str) { return str; }
+    static std::string utf8(std::string&& str) { return std::move(str); }
+    static const std::string& native(const std::string& str) { return str; }
+    static std::string native(std::string&& str) { return std::move(str); }
+    static std::string native(const char* str) { return std::string(str); }
+    static std::string native(const char* str, size_t length) { return std::string(str, length); }
+
+    static std::wstring wide(const std::string& str)
+    {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
+        return conv.from_bytes(str);
+    }
+
+    static std::string native(const std::wstring& wstr)
+    {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
+        return conv.to_bytes(wstr);
+    }
+
+    static std::string native(const wchar_t* wstr)
+    {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
+        return conv.to_bytes(wstr);
+    }
+
+    static std::string native(const wchar_t* wstr, size_t length)
+    {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
+        return conv.to_bytes(wstr, wstr + length);
+    }
+};
+
+template <typename CharT>
+class BasicJsonW;
+
+// BasicJsonPointerW is a RFC 6901 json pointer compiled once, e.g. "/a/b/3"
+// or "/a~1b/m~0n" for key "a/b" and "m~n". Each reference token is kept as
+// a hashed JsonKeyW in the key encoding of BasicJsonW<CharT> together with
+// its array index, so BasicJsonW::find() does no parsing, conversion or
+// allocation. Empty pointer refers to the whole value. JsonPointerW is used
+// with JsonW and JsonPointerU8 with JsonU8.
+template <typename CharT>
+class BasicJsonPointerW
+{
+public:
+    typedef std::basic_string<CharT> String;
+    typedef JsonKeyW<CharT> Key;
+
+    // index of a token that is not an array index, e.g. "-" or "name"
+    const static size_t NO_INDEX = (size_t)-1;
+
+public:
+    BasicJsonPointerW() : valid_(true)
+    {
+    }
+
+    explicit BasicJsonPointerW(const std::string& pointer)
+    {
+        compile(JsonTraitsW<CharT>::native(pointer));
+    }
+
+    explicit BasicJsonPointerW(const std::wstring& pointer)
+    {
+        compile(JsonTraitsW<CharT>::native(pointer));
+    }
+
+    // false if pointer is not empty and does not start with '/', or has '~'
+    // not followed by '0' or '1'
+    bool valid() const { return valid_; }
+
+    // number of reference tokens
+    size_t size() const { return tokens_.size(); }
+
+private:
+    friend class BasicJsonW<CharT>;
+
+    struct Token
+    {
+        Key key;
+        size_t index;
+    };
+
+    void compile(const String& pointer)
+    {
+        valid_ = pointer.empty() || pointer[0] == '/';
+
+        size_t begin = 1;
+        while (valid_ && begin <= pointer.length())
+        {
+            size_t end = pointer.find((CharT)'/', begin);
+            if (end == String::npos)
+            {
+                end = pointer.length();
+            }
+
+            String text;
+            text.reserve(end - begin);
+            for (size_t i = begin; i < end; i++)
+            {
+                if (pointer[i] != '~')
+                {
+                    text.push_back(pointer[i]);
+                }
+                else if (i + 1 < end && (pointer[i + 1] == '0' || pointer[i + 1] == '1'))
+                {
+                    text.push_back(pointer[++i] == '0' ? (CharT)'~' : (CharT)'/');
+                }
+                else
+                {
+                    valid_ = false;
+                }
+            }
+
+            Token token = { Key(text), index(text) };
+            tokens_.push_back(std::move(token));
+            begin = end + 1;
+        }
+
+        if (!valid_)
+        {
+            tokens_.clear();
+        }
+    }
+
+    // array index is "0" or digits without leading zero
+    static size_t index(const String& text)
+    {
+        if (text.empty() || text.length() > 18 || (text[0] == '0' && text.length() > 1))
+        {
+            return NO_INDEX;
+        }
+
+        size_t value = 0;
+        for (size_t i = 0; i < text.length(); i++)
+        {
+            if (text[i] < '0' || text[i] > '9')
+            {
+                return NO_INDEX;
+            }
+            value = value * 10 + (size_t)(text[i] - '0');
+        }
+
+        return value;
+    }
+
+private:
+    std::vector<Token> tokens_;
+    bool valid_;
+};
+
+typedef BasicJsonPointerW<wchar_t> JsonPointerW;
+typedef BasicJsonPointerW<char> JsonPointerU8;
+
+template <typename CharT>
+class BasicJsonPushParserW;
+
+// BasicJsonW is the class that caller should access, see also JsonDocumentW.
+// It represents a json 'value' defined in json standard. In other words,
+// it could be a number, a string, a boolean, a null, a json array or an
+// json object. See README.md for the usage.
+//
+// The string and the key are stored in CharT, JsonW (wchar_t) stores ucs
+// text and JsonU8 (char) stores utf8 text as it is in the json source.
+// Both of them accept and return std::string and std::wstring.
+template <typename CharT>
+class BasicJsonW
+{
+public:
+    typedef std::basic_string<CharT> String;
+    typedef JsonTraitsW<CharT> Traits;
+    typedef JsonKeyW<CharT> Key;
+    typedef JsonObjectW<Key, std::shared_ptr<BasicJsonW>> Object;
+
+public:
+    // type of jsonw
+    const static int BAD = 0;
+    const static int OBJECT = 1;    
+    const static int ARRAY  = 2;
+    const static int INTEGER  = 3;
+    const static int FLOAT = 4;
+    const static int STRING = 5;
+    const static int BOOLEAN = 6;
+    const static int NULLVALUE = 7;
+
+public:
+    // construtor and destructor
+    // 1. default constructor - NULL value
+    // 2. copy constructor - share the storage until one of them changes
+    // 3. move constructor - take the value, rhs becomes NULL value
+    // 4. construct by utf8 file input stream 
+    // 5. construct by utf8 string (std::string / const char*)
+    // 6. construct by ucs string (std::wstring / const wchar_t*)
+    // 7. construct by utf8 or ucs string with parse options
+    // 8. construct by a sequence of token (JsonTokenW)
+    // 9. destrcutor that calls help function clean()
+    BasicJsonW()
+    {
+        type_ = NULLVALUE;
+        valid_ = true;
+    }
+
+    explicit BasicJsonW(const BasicJsonW& rhs)
+    {
+        copy(rhs);
+    }
+
+    BasicJsonW(BasicJsonW&& rhs)
+    {
+        steal(rhs);
+    }
+
+    explicit BasicJsonW(std::ifstream& fin)
+    {
+        // read the rest of the file into std::string
+        std::string utf8str;
+        if (!JsonFileW::read(fin, utf8str))
+        {
+            return;
+        }
+
+        // parse the utf8 data directly
+        init(utf8str.data(), utf8str.length());
+    }
+
+    explicit BasicJsonW(const char* utf8str)
+    {
+        init(utf8str, std::strlen(utf8str));
+    }
+
+    explicit BasicJsonW(const wchar_t* wstr)
+    {
+        init(wstr, std::wcslen(wstr));
+    }
+
+    BasicJsonW(const wchar_t* ucsdata, size_t size)
+    {
+        init(ucsdata, size);
+    }
+
+    BasicJsonW(const char* utf8data, size_t length)
+    {
+        init(utf8data, length);
+    }
+
+    // parse with options, such as arena and object layout, see JsonOptionsW
+    BasicJsonW(const char* utf8data, size_t length, const JsonOptionsW& options)
+    {
+        init(utf8data, length, options);
+    }
+
+    BasicJsonW(const wchar_t* ucsdata, size_t size, const JsonOptionsW& options)
+    {
+        init(ucsdata, size, options);
+    }
+
+    // parse utf8 json file at 'path' in place from a memory mapping, see
+    // JsonFileW. The json is invalid if the file cannot be read.
+    static std::shared_ptr<BasicJsonW> load(const std::string& path,
+        const JsonOptionsW& options = JsonOptionsW())
+    {
+        std::shared_ptr<BasicJsonW> json = node(options.arena);
+        std::shared_ptr<JsonFileW> file = std::make_shared<JsonFileW>(path);
+
+        // lazy json keeps the mapping until all values are parsed
+        if (file->good())
+        {
+            json->init(file->data(), file->size(), options, file);
+        }
+        else
+        {
+            json->clean(BAD);
+            json->valid_ = false;
+        }
+
+        return json;
+    }
+    
+    ~BasicJsonW()
+    {
+        clean();
+    }
+
+public:    
+    BasicJsonW(std::queue<JsonTokenW>& tokens)
+    {
+        parse(tokens);
+    }
+    
+private:
+    // text of lazy parse and its options, shared by all deferred values
+    // of the text. 'owner' keeps the text alive.
+    struct Source
+    {
+        std::shared_ptr<const void> owner;
+        bool wide = false;
+        JsonOptionsW options;
+    };
+
+    // deferred object or array, text [begin, end) is parsed on first access
+    struct Lazy
+    {
+        std::shared_ptr<Source> source;
+        const void* begin;
+        const void* end;
+    };
+
+    // string, object and array storage follows this reference counted
+    // header in one allocation. Copies of a value share the storage, the
+    // one changing it takes its own storage first, see unshare(). Object
+    // and array storage whose members can be changed in place is
+    // 'exposed' and not shared by copies, see expose() and held(). The
+    // flags are only set by the owner of the storage, copies read them.
+    struct alignas(alignof(std::max_align_t)) Shared
+    {
+        std::atomic<uint32_t> references;
+        std::atomic<uint8_t> exposed;
+    };
+
+    // members handed out by get(), exposed while one is still held
+    const static uint8_t HANDED = 1;
+
+    // member referenced by operator[] or emplace(), exposed for good
+    const static uint8_t REFERENCED = 2;
+
+    // members of lazy parse, parsed in place when they are first read
+    const static uint8_t DEFERRED = 4;
+
+    template <typename T, typename... Args>
+    static T* create(Args&&... args)
+    {
+        void* memory = ::operator new(sizeof(Shared) + sizeof(T));
+        Shared* shared = new (memory) Shared();
+
+        shared->references = 1;
+        shared->exposed = 0;
+        return new (shared + 1) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static Shared* header(const T* storage)
+    {
+        return reinterpret_cast<Shared*>(const_cast<T*>(storage)) - 1;
+    }
+
+    template <typename T>
+    static T* share(T* storage)
+    {
+        header(storage)->references++;
+        return storage;
+    }
+
+    template <typename T>
+    static void release(T* storage)
+    {
+        Shared* shared = header(storage);
+
+        if (--shared->references == 0)
+        {
+            storage->~T();
+            shared->~Shared();
+            ::operator delete(shared);
+        }
+    }
+
+    template <typename T>
+    static bool shared(const T* storage)
+    {
+        return header(storage)->references > 1;
+    }
+
+    // read json data from a sequence of tokens
+    void parse(std::queue<JsonTokenW>& tokens)
+    {
+        clean(BAD);
+
+        if (tokens.empty())
+            return;
+
+        valid_ = true;
+
+        switch (tokens.front().type())
+        {
+        case JsonTokenW::Type::LeftCurlyBracket: // object
+            clean(OBJECT);
+            valid_ = jobject(tokens, *jobject_);
+            if (!valid_)
+            {
+                clean(BAD);
+                valid_ = false;
+            }
+            return;
+        case JsonTokenW::Type::LeftSquareBracket: // array
+            clean(ARRAY);
+            valid_ = jarray(tokens, *jarray_);
+            if (!valid_)
+            {
+                clean(BAD);
+                valid_ = false;
+            }
+            return;
+        case JsonTokenW::Type::NumberInteger:
+            type_ = INTEGER;
+            integer_ = tokens.front().integer();
+            tokens.pop();
+            return;
+        case JsonTokenW::Type::NumberFloat:
+            type_ = FLOAT;
+            frac_ = tokens.front().frac();
+            tokens.pop();
+            return;
+        case JsonTokenW::Type::String:
+            clean(STRING);
+            *string_ = Traits::native(tokens.front().wstring());
+            tokens.pop();
+            return;
+        case JsonTokenW::Type::Boolean:
+            type_ = BOOLEAN;
+            boolean_ = tokens.front().boolean();
+            tokens.pop();
+            return;
+        case JsonTokenW::Type::Null:
+            type_ = NULLVALUE;
+            tokens.pop();
+            return;
+        default: // bad token
+            valid_ = false;
+            return;
+        }
+    }
+
+    // read json data from text in single pass, 'cur' is moved to the
+    // next character after the json value. Nodes are built while scanning
+    // so no token is created. Child nodes are allocated from the arena of
+    // 'options' if it is not null. Child object and array are deferred if
+    // 'source' is not null.
+    template <typename TextT>
+    void parse(const TextT*& cur, const TextT* end, const JsonOptionsW& options,
+        const std::shared_ptr<Source>& source = std::shared_ptr<Source>())
+    {
+        clean(BAD);
+        valid_ = false;
+
+        if (!JsonTokenW::skip(cur, end))
+            return;
+
+        int_fast64_t integer;
+        long double frac;
+
+        switch (*cur)
+        {
+        case '{': // object
+            clean(OBJECT, options.objects);
+            valid_ = jobject(cur, end, *jobject_, options, source);
+            if (!valid_)
+            {
+                clean(BAD);
+                valid_ = false;
+            }
+            else if (source)
+            {
+                header(jobject_)->exposed |= DEFERRED;
+            }
+            return;
+        case '[': // array
+            clean(ARRAY);
+            valid_ = jarray(cur, end, *jarray_, options, source);
+            if (!valid_)
+            {
+                clean(BAD);
+                valid_ = false;
+            }
+            else if (source)
+            {
+                header(jarray_)->exposed |= DEFERRED;
+            }
+            return;
+        case '\"':
+            clean(STRING);
+            valid_ = JsonTokenW::scanstring(cur, end, *string_);
+            if (!valid_)
+            {
+                clean(BAD);
+                valid_ = false;
+            }
+            return;
+        case 't':
+            valid_ = JsonTokenW::scanliteral(cur, end, "true");
+            if (valid_)
+            {
+                type_ = BOOLEAN;
+                boolean_ = true;
+            }
+            return;
+        case 'f':
+            valid_ = JsonTokenW::scanliteral(cur, end, "false");
+            if (valid_)
+            {
+                type_ = BOOLEAN;
+                boolean_ = false;
+            }
+            return;
+        case 'n':
+            valid_ = JsonTokenW::scanliteral(cur, end, "null");
+            if (valid_)
+            {
+                type_ = NULLVALUE;
+            }
+            return;
+        case '-': case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            switch (JsonTokenW::scannumber(cur, end, integer, frac))
+            {
+            case JsonTokenW::Type::NumberInteger:
+                type_ = INTEGER;
+                integer_ = integer;
+                valid_ = true;
+                return;
+            case JsonTokenW::Type::NumberFloat:
+                type_ = FLOAT;
+                frac_ = frac;
+                valid_ = true;
+                return;
+            default:
+                return;
+            }
+        default: // not a valid begin character of json value
+            return;
+        }
+    }
+
+    // copy from another JsonW in constant time, string, object and array
+    // storage is shared with rhs until one of them changes it. Exposed
+    // storage is cloned one level, its members are copied in the same way.
+    void copy(const BasicJsonW& rhs)
+    {
+        if (this == &rhs)
+        {
+            return;
+        }
+
+        // deferred value shares the text with rhs
+        if (rhs.deferred_)
+        {
+            Lazy* lazy = new Lazy(*rhs.lazy_);
+            int type = rhs.type_;
+
+            clean(BAD);
+            type_ = type;
+            valid_ = true;
+            deferred_ = true;
+            lazy_ = lazy;
+            return;
+        }
+
+        // take the reference before clean(), rhs may be a child of 'this'
+        int type = rhs.type_;
+        bool valid = rhs.valid_;
+        long long integer = 0;
+        long double frac = 0;
+        bool boolean = false;
+        void* storage = nullptr;
+
+        switch (type)
+        {
+        case OBJECT:
+            storage = rhs.held() ? duplicate(*rhs.jobject_) : share(rhs.jobject_);
+            break;
+        case ARRAY:
+            storage = rhs.held() ? duplicate(*rhs.jarray_) : share(rhs.jarray_);
+            break;
+        case INTEGER:
+            integer = rhs.integer_;
+            break;
+        case FLOAT:
+            frac = rhs.frac_;
+            break;
+        case STRING:
+            storage = share(rhs.string_);
+            break;
+        case BOOLEAN:
+            boolean = rhs.boolean_;
+            break;
+        default:
+            break;
+        }
+
+        clean(BAD);
+        type_ = type;
+        valid_ = valid;
+
+        switch (type)
+        {
+        case OBJECT:
+            jobject_ = static_cast<Object*>(storage);
+            break;
+        case ARRAY:
+            jarray_ = static_cast<std::vector<std::shared_ptr<BasicJsonW>>*>(storage);
+            break;
+        case INTEGER:
+            integer_ = integer;
+            break;
+        case FLOAT:
+            frac_ = frac;
+            break;
+        case STRING:
+            string_ = static_cast<String*>(storage);
+            break;
+        case BOOLEAN:
+            boolean_ = boolean;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // private help function, deep copy from another JsonW, 'this' must be
+    // an empty value that is not a member of rhs
+    void clone(const BasicJsonW& rhs)
+    {
+        if (rhs.deferred_)
+        {
+            copy(rhs);
+            return;
+        }
+
+        clean(rhs.type_, rhs.type_ == OBJECT ? rhs.jobject_->layout() : JsonOptionsW::DEFAULT_OBJECT);
+        valid_ = rhs.valid_;
+
+        switch (rhs.type_)
+        {
+        case OBJECT:
+            jobject_->reserve(rhs.jobject_->size());
+            for (const auto& it : rhs.members())
+            {
+                std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+                jvalue->clone(*(it.second.get()));
+                jobject_->append(std::make_pair(it.first, jvalue));
+            }
+            jobject_->finish();
+            break;
+        case ARRAY:
+            jarray_->reserve(rhs.jarray_->size());
+            for (const auto& it : *rhs.jarray_)
+            {
+                std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+                jvalue->clone(*(it.get()));
+                jarray_->push_back(jvalue);
+            }
+            break;
+        case INTEGER:
+            integer_ = rhs.integer_;
+            break;
+        case FLOAT:
+            frac_ = rhs.frac_;
+            break;
+        case STRING:
+            *string_ = *rhs.string_;
+            break;
+        case BOOLEAN:
+            boolean_ = rhs.boolean_;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // private help function, true if 'node' is a member of 'this' or of its
+    // members. Shared storage is not searched, operator[] never returns a
+    // member of it since it takes own storage on the way down.
+    bool contains(const BasicJsonW* node) const
+    {
+        if (deferred_)
+        {
+            return false;
+        }
+
+        switch (type_)
+        {
+        case OBJECT:
+            if (!shared(jobject_))
+            {
+                for (const auto& it : members())
+                {
+                    if (it.second.get() == node || it.second->contains(node))
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        case ARRAY:
+            if (!shared(jarray_))
+            {
+                for (const auto& it : *jarray_)
+                {
+                    if (it.get() == node || it->contains(node))
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        default:
+            return false;
+        }
+    }
+
+    // private static help function, new storage of the members as new
+    // values that still share their own storage, one level is cloned.
+    // Members of lazy parse keep their own deferred text, the new storage
+    // is DEFERRED as well.
+    static Object* duplicate(const Object& members)
+    {
+        Object* jobject = create<Object>(members.layout());
+        header(jobject)->exposed = header(&members)->exposed & DEFERRED;
+
+        jobject->reserve(members.size());
+        for (const auto& it : members)
+        {
+            // key is immutable and shared
+            jobject->append(std::make_pair(it.first, std::make_shared<BasicJsonW>(*(it.second.get()))));
+        }
+        jobject->finish();
+
+        return jobject;
+    }
+
+    static std::vector<std::shared_ptr<BasicJsonW>>* duplicate(const std::vector<std::shared_ptr<BasicJsonW>>& values)
+    {
+        std::vector<std::shared_ptr<BasicJsonW>>* jarray = create<std::vector<std::shared_ptr<BasicJsonW>>>();
+        header(jarray)->exposed = header(&values)->exposed & DEFERRED;
+
+        jarray->reserve(values.size());
+        for (const auto& it : values)
+        {
+            jarray->push_back(std::make_shared<BasicJsonW>(*(it.get())));
+        }
+
+        return jarray;
+    }
+
+    // private help function, take own storage before 'this' changes it if
+    // the storage is shared with copies
+    void unshare()
+    {
+        if (deferred_)
+        {
+            return;
+        }
+
+        switch (type_)
+        {
+        case OBJECT:
+            if (shared(jobject_))
+            {
+                Object* jobject = duplicate(*jobject_);
+
+                release(jobject_);
+                jobject_ = jobject;
+            }
+            break;
+        case ARRAY:
+            if (shared(jarray_))
+            {
+                std::vector<std::shared_ptr<BasicJsonW>>* jarray = duplicate(*jarray_);
+
+                release(jarray_);
+                jarray_ = jarray;
+            }
+            break;
+        case STRING:
+            if (shared(string_))
+            {
+                String* str = create<String>(*string_);
+
+                release(string_);
+                string_ = str;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    // private help function, take own storage of object or array 'type'
+    // before a member is handed out, 'how' is HANDED or REFERENCED. The
+    // storage is exposed, a later copy clones it, see held().
+    void expose(int type, uint8_t how = HANDED)
+    {
+        expand();
+
+        if (type_ != type)
+        {
+            return;
+        }
+
+        unshare();
+        if (type == OBJECT)
+        {
+            header(jobject_)->exposed |= how;
+        }
+        else if (type == ARRAY)
+        {
+            header(jarray_)->exposed |= how;
+        }
+    }
+
+    // private help function, true if a copy must clone the storage: a
+    // member of it was referenced or is parsed in place on first read, or
+    // a member handed out by get() is still held, also in the exposed
+    // storage below it. Only reads the flags, copies of one value can be
+    // taken by threads.
+    bool held() const
+    {
+        if (deferred_)
+        {
+            return true;
+        }
+
+        if (type_ != OBJECT && type_ != ARRAY)
+        {
+            return false;
+        }
+
+        const Shared* shared = type_ == OBJECT ? header(jobject_) : header(jarray_);
+        uint8_t exposed = shared->exposed;
+        if (exposed == 0)
+        {
+            return false;
+        }
+
+        if (exposed & (REFERENCED | DEFERRED))
+        {
+            return true;
+        }
+
+        if (type_ == OBJECT)
+        {
+            for (const auto& it : members())
+            {
+                if (it.second.use_count() > 1 || it.second->held())
+                {
+                    return true;
+                }
+            }
+        }
+        else
+        {
+            for (const auto& it : *jarray_)
+            {
+                if (it.use_count() > 1 || it->held())
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // take the value of another JsonW without copy, string, object and
+    // array storage moves to 'this' and rhs becomes NULL value
+    void steal(BasicJsonW& rhs)
+    {
+        if (this == &rhs)
+        {
+            return;
+        }
+
+        // detach rhs before clean(), rhs may be a child of 'this'
+        BasicJsonW detached;
+        detached.take(rhs);
+
+        clean();
+        take(detached);
+    }
+
+    // move the value of rhs into 'this' which holds no storage
+    void take(BasicJsonW& rhs)
+    {
+        type_ = rhs.type_;
+        valid_ = rhs.valid_;
+        deferred_ = rhs.deferred_;
+
+        if (deferred_)
+        {
+            lazy_ = rhs.lazy_;
+        }
+        else
+        {
+            switch (type_)
+            {
+            case OBJECT:
+                jobject_ = rhs.jobject_;
+                break;
+            case ARRAY:
+                jarray_ = rhs.jarray_;
+                break;
+            case STRING:
+                string_ = rhs.string_;
+                break;
+            case FLOAT:
+                frac_ = rhs.frac_;
+                break;
+            case BOOLEAN:
+                boolean_ = rhs.boolean_;
+                break;
+            default:
+                integer_ = rhs.integer_;
+                break;
+            }
+        }
+
+        rhs.type_ = NULLVALUE;
+        rhs.valid_ = true;
+        rhs.deferred_ = false;
+        rhs.integer_ = 0;
+    }
+
+public:
+    // return false if json data is invalid
+    bool valid() const { return valid_; }
+    
+    // get type of jsonw
+    int type() const { return type_; }
+    
+    //
+    // simple data accessors
+    //
+
+    // get the number of data in this json value
+    // for number, string and boolean, return 1
+    // for array, return the number of values inside it
+    // for object, return the number of name-value pairs inside it
+    // others return 0
+    size_t size() const
+    {
+        expand();
+
+        switch (type_)
+        {
+        case BAD:
+            return 0;
+        case OBJECT:
+            return jobject_->size();
+        case ARRAY:
+            return jarray_->size();
+        case INTEGER:
+        case FLOAT:
+        case STRING:
+        case BOOLEAN:
+            return 1;
+        case NULLVALUE:
+        default:
+            return 0;
+        }
+    }
+
+    // value of other type returns the default value
+    long long integer() const { return type_ == INTEGER ? integer_ : 0; }
+    long double frac() const { return type_ == FLOAT ? frac_ : 0.0; }
+    std::wstring wstr() const & { return type_ == STRING ? Traits::wide(*string_) : std::wstring(); }
+    std::string str() const & { return type_ == STRING ? Traits::utf8(*string_) : std::string(); }
+
+    // string of a temporary JsonW is moved out if no conversion is needed
+    std::wstring wstr() && { unshare(); return type_ == STRING ? Traits::wide(std::move(*string_)) : std::wstring(); }
+    std::string str() && { unshare(); return type_ == STRING ? Traits::utf8(std::move(*string_)) : std::string(); }
+    bool boolean() const { return type_ == BOOLEAN ? boolean_ : true; }
+
+    void integer(long long integer)
+    {
+        clean(INTEGER);
+        integer_ = integer;
+    }
+
+    void frac(long double frac)
+    {
+        clean(FLOAT);
+        frac_ = frac;
+    }
+
+    void wstr(const std::wstring& wstr)
+    {
+        clean(STRING);
+        *string_ = Traits::native(wstr);
+    }
+
+    void wstr(std::wstring&& wstr)
+    {
+        clean(STRING);
+        *string_ = Traits::native(std::move(wstr));
+    }
+
+    void wstr(const wchar_t* wstr)
+    {
+        clean(STRING);
+        *string_ = Traits::native(wstr);
+    }
+
+    void wstr(const wchar_t* wstr, size_t length)
+    {
+        clean(STRING);
+        *string_ = Traits::native(wstr, length);
+    }
+
+    void str(const std::string& str)
+    {
+        clean(STRING);
+        *string_ = Traits::native(str);
+    }
+
+    void str(std::string&& str)
+    {
+        clean(STRING);
+        *string_ = Traits::native(std::move(str));
+    }
+
+    void str(const char* str)
+    {
+        clean(STRING);
+        *string_ = Traits::native(str);
+    }
+
+    void str(const char* str, size_t length)
+    {
+        clean(STRING);
+        *string_ = Traits::native(str, length);
+    }
+
+    void boolean(bool boolean)
+    {
+        clean(BOOLEAN);
+        boolean_ = boolean;
+    }
+
+    void reset()
+    {
+        clean();
+    }
+
+    void json(const std::string& text)
+    {
+        json(text.data(), text.length());
+    }
+
+    void json(const char* text)
+    {
+        json(text, std::strlen(text));
+    }
+
+    void json(const char* text, size_t size)
+    {
+        clean();
+        init(text, size);
+    }
+
+    //
+    // json object accessor member
+    //
+    
+    // return all available keys in either ucs or utf8 enconding
+    void wkeys(std::vector<std::wstring>& keys) const
+    {
+        expand();
+
+        if (type_ != OBJECT)
+        {
+            return;
+        }
+
+        for (auto it = members().begin(); it != members().end(); it++)
+        {
+            keys.push_back(Traits::wide(it->first.str()));
+        }
+
+        return;
+    }
+
+    void keys(std::vector<std::string>& keys) const
+    {
+        expand();
+
+        if (type_ != OBJECT)
+        {
+            return;
+        }
+
+        for (auto it = members().begin(); it != members().end(); it++)
+        {
+            keys.push_back(Traits::utf8(it->first.str()));
+        }
+
+        return;
+    }
+
+    // get json value via specific key, return nullptr if
+    // no such entry or 'this' is not an json object. The value can be
+    // changed in place, it is not shared with copies of 'this'. The value
+    // of a const json is only read, it may be shared with copies.
+    std::shared_ptr<BasicJsonW> get(const std::wstring& wkey)
+    {
+        expose(OBJECT);
+        return member(Traits::native(wkey));
+    }
+
+    std::shared_ptr<BasicJsonW> get(const std::string& key)
+    {
+        expose(OBJECT);
+        return member(Traits::native(key));
+    }
+
+    std::shared_ptr<const BasicJsonW> get(const std::wstring& wkey) const
+    {
+        return member(Traits::native(wkey));
+    }
+
+    std::shared_ptr<const BasicJsonW> get(const std::string& key) const
+    {
+        return member(Traits::native(key));
+    }
+
+    // get json value by key literal, e.g. get("id"_jk), the key is neither
+    // converted nor hashed at run time
+    template <typename T>
+    std::shared_ptr<BasicJsonW> get(const JsonKeyLiteralW<T>& key)
+    {
+        expose(OBJECT);
+        return member(key);
+    }
+
+    template <typename T>
+    std::shared_ptr<const BasicJsonW> get(const JsonKeyLiteralW<T>& key) const
+    {
+        return member(key);
+    }
+
+private:
+    // private help function - object member by key literal
+    template <typename T>
+    std::shared_ptr<BasicJsonW> member(const JsonKeyLiteralW<T>& key) const
+    {
+        if (!key.template comparable<CharT>())
+        {
+            return member(keytext(key));
+        }
+
+        expand();
+
+        if (type_ != OBJECT)
+        {
+            return nullptr;
+        }
+
+        auto it = jobject_->find(key);
+        if (it == jobject_->end())
+        {
+            return nullptr;
+        }
+
+        return it->second;
+    }
+
+public:
+    // call 'callback(key, value)' for each member of json object in the
+    // order of text(), callback returns false to stop and then foreach()
+    // returns false. Key keeps its hash, so members can be dispatched by
+    // switch (key.hash()) with case labels of "name"_jk.hash(). The value
+    // is const, it may be shared with copies of 'this'.
+    template <typename Callback>
+    bool foreach(Callback callback) const
+    {
+        expand();
+
+        if (type_ != OBJECT)
+        {
+            return true;
+        }
+
+        for (const auto& it : members())
+        {
+            const BasicJsonW& jvalue = *(it.second);
+            if (!callback(it.first, jvalue))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // get json value by RFC 6901 json pointer, e.g. "/a/b/3/c", return
+    // nullptr if no such value or the pointer is malformed. 'this' is never
+    // changed. Compile the pointer once by JsonPointerW (JsonPointerU8 for
+    // JsonU8) to look up the same path in many values.
+    const BasicJsonW* find(const BasicJsonPointerW<CharT>& pointer) const
+    {
+        if (!pointer.valid())
+        {
+            return nullptr;
+        }
+
+        const BasicJsonW* jvalue = this;
+
+        for (const auto& token : pointer.tokens_)
+        {
+            jvalue->expand();
+
+            if (jvalue->type_ == OBJECT)
+            {
+                auto it = jvalue->jobject_->find(token.key);
+                if (it == jvalue->jobject_->end())
+                {
+                    return nullptr;
+                }
+                jvalue = it->second.get();
+            }
+            else if (jvalue->type_ == ARRAY && token.index < jvalue->jarray_->size())
+            {
+                jvalue = (*jvalue->jarray_)[token.index].get();
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+
+        return jvalue;
+    }
+
+    const BasicJsonW* find(const std::wstring& pointer) const
+    {
+        return find(BasicJsonPointerW<CharT>(pointer));
+    }
+
+    const BasicJsonW* find(const std::string& pointer) const
+    {
+        return find(BasicJsonPointerW<CharT>(pointer));
+    }
+    
+    // delete a name-pair value inside json object by the name
+    // return false if no such value
+    bool erase(std::wstring wkey)
+    {
+        return erasemember(Traits::native(wkey));
+    }
+    
+    bool erase(std::string key)
+    {
+        return erasemember(Traits::native(key));
+    }
+
+    // set json value using specific key, return false
+    // if key length is 0
+    bool add(std::wstring wkey, std::shared_ptr<BasicJsonW> jvalue)
+    {
+        return addmember(Traits::native(wkey), std::move(jvalue));
+    }
+
+    bool add(std::string key, std::shared_ptr<BasicJsonW> jvalue)
+    {
+        return addmember(Traits::native(key), std::move(jvalue));
+    }
+
+    // move the value and its children into json object without copy
+    bool add(std::wstring wkey, BasicJsonW&& jvalue)
+    {
+        return add(wkey, std::make_shared<BasicJsonW>(std::move(jvalue)));
+    }
+
+    bool add(std::string key, BasicJsonW&& jvalue)
+    {
+        return add(key, std::make_shared<BasicJsonW>(std::move(jvalue)));
+    }
+
+    // add a NULL value member and return it to be filled in place, the
+    // existing member of the key is replaced. Return bad() if key length
+    // is 0.
+    BasicJsonW& emplace(const std::wstring& wkey)
+    {
+        return emplacemember(Traits::native(wkey));
+    }
+
+    BasicJsonW& emplace(const std::string& key)
+    {
+        return emplacemember(Traits::native(key));
+    }
+
+    bool add(std::wstring wkey, long long integer)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->integer(integer);
+        return add(wkey, std::move(jvalue));
+    }
+
+    bool add(std::wstring wkey, long integer)
+    {
+        return add(wkey, (long long)integer);
+    }
+
+    bool add(std::wstring wkey, int integer)
+    {
+        return add(wkey, (long long)integer);
+    }
+
+    bool add(std::wstring wkey, short integer)
+    {
+        return add(wkey, (long long)integer);
+    }
+
+    bool add(std::string key, long long integer)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->integer(integer);
+        return add(key, std::move(jvalue));
+    }
+
+    bool add(std::string key, long integer)
+    {
+        return add(key, (long long)integer);
+    }
+
+    bool add(std::string key, int integer)
+    {
+        return add(key, (long long)integer);
+    }
+
+    bool add(std::string key, short integer)
+    {
+        return add(key, (long long)integer);
+    }
+
+    bool add(std::wstring wkey, long double frac)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->frac(frac);
+        return add(wkey, std::move(jvalue));
+    }
+
+    bool add(std::wstring wkey, double frac)
+    {
+        return add(wkey, (long double)frac);
+    }
+
+    bool add(std::wstring wkey, float frac)
+    {
+        return add(wkey, (long double)frac);
+    }
+
+    bool add(std::string key, long double frac)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->frac(frac);
+        return add(key, std::move(jvalue));
+    }
+
+    bool add(std::string key, double frac)
+    {
+        return add(key, (long double)frac);
+    }
+
+    bool add(std::string key, float frac)
+    {
+        return add(key, (long double)frac);
+    }
+
+    bool add(std::wstring wkey, std::wstring wstr)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->wstr(std::move(wstr));
+        return add(wkey, std::move(jvalue));
+    }
+
+    bool add(std::string key, std::string str)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->str(std::move(str));
+        return add(key, std::move(jvalue));
+    }
+
+    bool add(std::wstring wkey, bool boolean )
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->boolean(boolean);
+        return add(wkey, std::move(jvalue));
+    }
+
+    bool add(std::string key, bool boolean)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->boolean(boolean);
+        return add(key, std::move(jvalue));
+    }
+
+    //
+    // json array accessors
+    //
+
+    // retrieve the json value in array, it is not shared with copies
+    // unless 'this' is const, see get(key)
+    std::shared_ptr<BasicJsonW> get(size_t idx)
+    {
+        expose(ARRAY);
+        return element(idx);
+    }
+
+    std::shared_ptr<const BasicJsonW> get(size_t idx) const
+    {
+        return element(idx);
+    }
+
+private:
+    // private help function - array element by index
+    std::shared_ptr<BasicJsonW> element(size_t idx) const
+    {
+        expand();
+
+        if (type_ != ARRAY || idx >= jarray_->size())
+        {
+            return nullptr;
+        }
+
+        return jarray_->at(idx);
+    }
+
+public:
+    // add one json value into array
+    bool add(std::shared_ptr<BasicJsonW> junit)
+    {
+        expand();
+
+        if (type_ != ARRAY)
+        {
+            clean(ARRAY);
+        }
+
+        // value kept by caller, or exposed below, can be changed in place
+        if (junit.use_count() > 1 || (junit != nullptr && junit->held()))
+        {
+            expose(ARRAY);
+        }
+        else
+        {
+            unshare();
+        }
+
+        if (junit == nullptr)
+        {
+            // NULLVALUE json value
+            jarray_->push_back(std::make_shared<BasicJsonW>());
+        }
+        else
+        {
+            jarray_->push_back(std::move(junit));
+        }
+        
+        valid_ = true;        
+        return true;
+    }
+
+    // move the value and its children into array without copy
+    bool add(BasicJsonW&& junit)
+    {
+        return add(std::make_shared<BasicJsonW>(std::move(junit)));
+    }
+
+    // add a NULL value into array and return it to be filled in place
+    BasicJsonW& emplace_back()
+    {
+        std::shared_ptr<BasicJsonW> junit = std::make_shared<BasicJsonW>();
+        add(junit);
+        expose(ARRAY, REFERENCED);
+        return *junit;
+    }
+
+    bool add(long long integer)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->integer(integer);
+        return add(std::move(jvalue));
+    }
+
+    bool add(long integer)
+    {
+        return add((long long)integer);
+    }
+
+    bool add(int integer)
+    {
+        return add((long long)integer);
+    }
+
+    bool add(short integer)
+    {
+        return add((long long)integer);
+    }
+
+    bool add(long double frac)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->frac(frac);
+        return add(std::move(jvalue));
+    }
+
+    bool add(double frac)
+    {
+        return add((long double)frac);
+    }
+
+    bool add(float frac)
+    {
+        return add((long double)frac);
+    }
+
+    bool add(std::wstring wstr)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->wstr(std::move(wstr));
+        return add(std::move(jvalue));
+    }
+
+    bool add(std::string str)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->str(std::move(str));
+        return add(std::move(jvalue));
+    }
+
+    bool add(bool boolean)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+        jvalue->boolean(boolean);
+        return add(std::move(jvalue));
+    }
+    
+    // delete a value inside json array by index, 
+    // return false if no such value.
+    bool erase(size_t idx)
+    {
+        expand();
+
+        if ( type_ != ARRAY )
+        {
+            return false;
+        }
+
+        if ( size() <= idx )
+        {
+            return false;
+        }
+
+        unshare();
+        jarray_->erase( jarray_->begin() + idx );
+        
+        return true;
+    }
+
+public:    
+    //
+    // operator overloading
+    //
+    BasicJsonW& operator=(short value)
+    {
+        clean(INTEGER);
+        valid_ = true;
+        integer_ = value;
+
+        return *this;
+    }
+
+    BasicJsonW& operator=(int value)
+    {
+        clean(INTEGER);
+        valid_ = true;
+        integer_ = value;
+
+        return *this;
+    }
+
+    BasicJsonW& operator=( long value )
+    {
+        clean(INTEGER);
+        valid_ = true;
+        integer_ = value;
+
+        return *this;
+    }
+
+    BasicJsonW& operator=(long long value)
+    {
+        clean(INTEGER);
+        valid_ = true;
+        integer_ = value;
+
+        return *this;
+    }
+    
+    BasicJsonW& operator=(long double value)
+    {
+        clean(FLOAT);
+        valid_ = true;
+        frac_ = value;
+
+        return *this;
+    }
+
+    BasicJsonW& operator=(double value)
+    {
+        clean(FLOAT);
+        valid_ = true;
+        frac_ = value;
+
+        return *this;
+    }
+
+    BasicJsonW& operator=(float value)
+    {
+        clean(FLOAT);
+        valid_ = true;
+        frac_ = value;
+
+        return *this;
+    }
+
+    BasicJsonW& operator=(const wchar_t* value)
+    {
+        clean(STRING);
+        valid_ = true;
+        *string_ = Traits::native(value);
+
+        return *this;
+    }
+    
+    BasicJsonW& operator=(std::wstring value)
+    {
+        clean(STRING);
+        valid_ = true;
+        *string_ = Traits::native(std::move(value));
+
+        return *this;
+    }
+
+    BasicJsonW& operator=(const char* value)
+    {
+        clean(STRING);
+        valid_ = true;
+        *string_ = Traits::native(value);
+
+        return *this;
+    }
+
+    BasicJsonW& operator=(std::string value)
+    {
+        clean(STRING);
+        valid_ = true;
+        *string_ = Traits::native(std::move(value));
+
+        return *this;
+    }
+   
+    BasicJsonW& operator=(bool boolean)
+    {
+        clean(BOOLEAN);
+        valid_ = true;
+        boolean_ = boolean;
+
+        return *this;
+    }    
+        
+    BasicJsonW& operator=(const BasicJsonW& junit)
+    {
+        // sharing the storage of an ancestor would make a cycle, take a
+        // deep copy when 'this' is a member of junit
+        if (junit.contains(this))
+        {
+            BasicJsonW jvalue;
+            jvalue.clone(junit);
+            steal(jvalue);
+        }
+        else
+        {
+            copy(junit);
+        }
+        return *this;
+    }
+
+    BasicJsonW& operator=(BasicJsonW&& junit)
+    {
+        steal(junit);
+        return *this;
+    }
+
+    BasicJsonW& operator[] (size_t index)
+    {
+        expand();
+
+        if (type_ != ARRAY)
+        {
+            clean(ARRAY);
+            valid_ = true;
+        }
+
+        expose(ARRAY, REFERENCED);
+
+        if (index >= size())
+        {
+            for (size_t i = size(); i <= index; i++)
+            {
+                add(std::make_shared<BasicJsonW>());
+            }
+        }
+
+        return *(element(index));
+    }
+
+    BasicJsonW& operator[] (int index)
+    {
+        if (index < 0)
+        {
+            return bad();
+        }
+
+        expand();
+
+        if (type_ != ARRAY)
+        {
+            clean(ARRAY);
+            valid_ = true;
+        }
+
+        expose(ARRAY, REFERENCED);
+
+        if (index >= (int)size())
+        {
+            for (size_t i = size(); i <= (size_t)index; i++)
+            {
+                add(std::make_shared<BasicJsonW>());
+            }
+        }
+
+        return *(element(index));
+    }
+
+    BasicJsonW& operator[] (const char* name)
+    {
+        return membervalue(Traits::native(name));
+    }
+
+    BasicJsonW& operator[] (const std::string& name)
+    {
+        return membervalue(Traits::native(name));
+    }
+
+    BasicJsonW& operator[] (const wchar_t* name)
+    {
+        return membervalue(Traits::native(name));
+    }
+
+    BasicJsonW& operator[] (const std::wstring& wname)
+    {
+        return membervalue(Traits::native(wname));
+    }
+
+    // existing member is found without converting or hashing the key,
+    // the key is converted only when it is added
+    template <typename T>
+    BasicJsonW& operator[] (const JsonKeyLiteralW<T>& key)
+    {
+        expand();
+
+        if (type_ == OBJECT && key.template comparable<CharT>() && !shared(jobject_))
+        {
+            auto it = jobject_->find(key);
+            if (it != jobject_->end())
+            {
+                header(jobject_)->exposed |= REFERENCED;
+                return *(it->second);
+            }
+        }
+
+        return membervalue(keytext(key));
+    }
+
+    // format json data into ucs text
+    std::wstring wtext( bool singleline = true ) const
+    {
+        return Traits::wide(native(singleline));
+    }
+
+    // format json data into utf8 text in json standard, the text is
+    // written in utf8 directly without the text of CharT
+    std::string text( bool singleline = true ) const
+    {
+        std::string buffer;
+        write(buffer, singleline);
+        return buffer;
+    }
+
+    // append json data in utf8 text to 'buffer'
+    void write(std::string& buffer, bool singleline = true) const
+    {
+        JsonWriterW writer(buffer);
+        write_jvalue(writer, *this, singleline);
+        writer.flush();
+    }
+
+    // write json data in utf8 text into 'sink' in blocks of
+    // JsonWriterW::BLOCK_SIZE bytes, return false if sink stops the writing
+    // or a value is invalid
+    bool write(JsonSinkW& sink, bool singleline = true) const
+    {
+        JsonWriterW writer(sink);
+        write_jvalue(writer, *this, singleline);
+        return writer.flush();
+    }
+
+    // exact length in bytes of text(singleline), throw std::range_error as
+    // text() does if a character has no utf8 form
+    size_t serialized_size( bool singleline = true ) const
+    {
+        JsonCounterW counter;
+        write_jvalue(counter, *this, singleline);
+
+        if (counter.invalid())
+        {
+            throw std::range_error("wstring_convert::to_bytes");
+        }
+        return counter.bytes();
+    }
+
+    // write text(singleline) into 'buffer' of 'capacity' bytes in one pass,
+    // no terminating zero is added. Return the length of the text, which is
+    // greater than 'capacity' if the text does not fit and is cut.
+    size_t serialize_to(char* buffer, size_t capacity, bool singleline = true) const
+    {
+        JsonWriterW writer(buffer, capacity);
+        write_jvalue(writer, *this, singleline);
+        return writer.length();
+    }
+
+    // format json data into text of CharT, which is wtext() for JsonW
+    // and text() for JsonU8
+    String native( bool singleline = true ) const
+    {
+        String buffer;
+        JsonNativeWriterW<CharT> writer(buffer);
+        write_jvalue(writer, *this, singleline);
+        return writer.good() ? buffer : String();
+    }
+
+    // encode json data in MessagePack, nothing is written for invalid json
+    // or json with an invalid deferred value or a long double above double
+    // range. The second one appends the bytes to 'buffer' and returns false
+    // if nothing is written. Throw std::range_error as text() does if a
+    // character has no utf8 form.
+    std::vector<uint8_t> to_msgpack() const
+    {
+        std::vector<uint8_t> buffer;
+        to_msgpack(buffer);
+        return buffer;
+    }
+
+    bool to_msgpack(std::vector<uint8_t>& buffer) const
+    {
+        expand();
+
+        if (!valid())
+        {
+            return false;
+        }
+
+        JsonBytesW out(buffer);
+        write_msgpack(out, *this);
+        out.flush();
+        return out.good();
+    }
+
+    // encode json data in CBOR (RFC 8949) in the same way as to_msgpack()
+    std::vector<uint8_t> to_cbor() const
+    {
+        std::vector<uint8_t> buffer;
+        to_cbor(buffer);
+        return buffer;
+    }
+
+    bool to_cbor(std::vector<uint8_t>& buffer) const
+    {
+        expand();
+
+        if (!valid())
+        {
+            return false;
+        }
+
+        JsonBytesW out(buffer);
+        write_cbor(out, *this);
+        out.flush();
+        return out.good();
+    }
+
+    // decode one MessagePack value that takes all 'length' bytes. The json
+    // is invalid if the data is malformed, has bytes after the value, has
+    // objects and arrays nested deeper than BINARY_DEPTH, or has the value
+    // that json does not have, which are binary, extension, non-string key
+    // and integer above INT64_MAX.
+    static BasicJsonW from_msgpack(const uint8_t* data, size_t length)
+    {
+        BasicJsonW json;
+        String key;
+        const uint8_t* cur = data;
+
+        if (!json.msgpack(cur, data + length, key, 0) || cur != data + length)
+        {
+            json.clean(BAD);
+            json.valid_ = false;
+        }
+        return json;
+    }
+
+    static BasicJsonW from_msgpack(const std::vector<uint8_t>& data)
+    {
+        return from_msgpack(data.data(), data.size());
+    }
+
+    // decode one CBOR value in the same way as from_msgpack(). Tag is
+    // skipped, undefined is read as null, byte string is invalid.
+    static BasicJsonW from_cbor(const uint8_t* data, size_t length)
+    {
+        BasicJsonW json;
+        String key;
+        const uint8_t* cur = data;
+
+        if (!json.cbor(cur, data + length, key, 0) || cur != data + length)
+        {
+            json.clean(BAD);
+            json.valid_ = false;
+        }
+        return json;
+    }
 
-// JsonTokenW presents a token in json data. It has a static member function 
-// 'parse()' that can parse the json from text to token. However, JsonW caller 
-// does not need to access this class at all. See README.md for detail.
-class JsonTokenW
-{
-public:
-    enum class Type
+    static BasicJsonW from_cbor(const std::vector<uint8_t>& data)
     {
-        NumberInteger,
-        NumberFloat,
-        String,
-        LeftCurlyBracket,
-        RightCurlyBracket,
-        LeftSquareBracket,
-        RightSquareBracket,
-        Colon,
-        Comma,
-        Boolean,
-        Null,
-        Bad
-    };
+        return from_cbor(data.data(), data.size());
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const BasicJsonW& rhs)
+    {
+        JsonStreamSinkW sink(os);
+        rhs.write(sink);
+        return os;
+    }
+
+    friend std::wostream& operator<<(std::wostream& wos, const BasicJsonW& rhs)
+    {
+        wos << rhs.wtext();
+        return wos;
+    }
+
+    // push parser builds nodes in place
+    friend class BasicJsonPushParserW<CharT>;
 
 public:
-    // parse json text from wistream instead of istream
-    JsonTokenW(std::wistream& ins)
+    // Singleton bad JsonW instance
+    static BasicJsonW& bad()
     {
-        type_ = Type::Bad;
-        wchar_t character;
+        static BasicJsonW instance;
+        instance.clean(BAD);
+        instance.valid_ = false;
+        return instance;
+    }
 
-        if (!ins.good())
+private:
+    // private help function, object storage to be read. A const object
+    // is listed without merging or compacting its members, see JsonObjectW.
+    const Object& members() const
+    {
+        return *jobject_;
+    }
+
+    // private help function - key literal in CharT, ascii literal is
+    // widened or narrowed unit by unit
+    template <typename T>
+    static String keytext(const JsonKeyLiteralW<T>& key)
+    {
+        if (key.template comparable<CharT>())
         {
-            return;
+            return String(key.data(), key.data() + key.length());
         }
 
-        character = ins.peek();
+        return Traits::native(key.str());
+    }
 
-        // return false if no more data to read
-        if (character == std::char_traits<wchar_t>::eof())
+    // private help function - object member by key in CharT
+    std::shared_ptr<BasicJsonW> member(const String& key) const
+    {
+        expand();
+
+        if (type_ != OBJECT)
         {
-            return;
+            return nullptr;
         }
 
-        // handle single character token
-        switch (character)
+        auto it = jobject_->find(key);
+        if (it == jobject_->end())
         {
-        case L'{': type_ = Type::LeftCurlyBracket;  ins.get(); return;
-        case L'}': type_ = Type::RightCurlyBracket; ins.get(); return;
-        case L'[': type_ = Type::LeftSquareBracket;   ins.get(); return;
-        case L']': type_ = Type::RightSquareBracket;  ins.get(); return;
-        case L':': type_ = Type::Colon;              ins.get(); return;
-        case L',': type_ = Type::Comma;              ins.get(); return;
+            return nullptr;
         }
 
-        // handle number
-        if (iswdigit(character) || character == L'-')
+        return it->second;
+    }
+
+    // private help function - object member by key, created as null value
+    // if not exists. 'this' becomes an object if it is not.
+    BasicJsonW& membervalue(const String& key)
+    {
+        if (key.length() == 0)
         {
-            std::wstring numberstr;
-            std::wstring expstr;
-            bool containdot = false;
-            bool containexp = false;
-            bool negativeexp = false;
-            int exponent = 0;
+            return bad();
+        }
 
-            // negative value
-            if (character == L'-')
-            {
-                numberstr.push_back(character);
-                ins.get();
-                character = ins.peek();
-            }
+        expand();
 
-            // if start with 0, it must followed by . or standalone zero
-            if (character == L'0')
-            {
-                numberstr.push_back(character);
-                ins.get();
-                character = ins.peek();
+        if (type_ != OBJECT)
+        {
+            clean(OBJECT);
+            valid_ = true;
+        }
+
+        expose(OBJECT, REFERENCED);
+
+        auto it = jobject_->find(key);
+        if (it == jobject_->end())
+        {
+            it = jobject_->insert(std::make_pair(key, std::make_shared<BasicJsonW>())).first;
+        }
+
+        return *(it->second);
+    }
+
+    bool addmember(const String& key, std::shared_ptr<BasicJsonW> jvalue)
+    {
+        if (key.length() == 0)
+        {
+            return false;
+        }
+
+        expand();
+
+        if (type_ != OBJECT)
+        {
+            clean(OBJECT);
+        }
+
+        // value kept by caller, or exposed below, can be changed in place
+        if (jvalue.use_count() > 1 || (jvalue != nullptr && jvalue->held()))
+        {
+            expose(OBJECT);
+        }
+        else
+        {
+            unshare();
+        }
+
+        (*jobject_)[key] = std::move(jvalue);
+        return true;
+    }
+
+    BasicJsonW& emplacemember(const String& key)
+    {
+        std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+
+        if (addmember(key, jvalue) == false)
+        {
+            return bad();
+        }
+
+        expose(OBJECT, REFERENCED);
+        return *jvalue;
+    }
+
+    bool erasemember(const String& key)
+    {
+        expand();
+
+        if (type_ != OBJECT)
+        {
+            return false;
+        }
+
+        auto it = jobject_->find(key);
+        if (it == jobject_->end())
+        {
+            return false;
+        }
+
+        // iterator of shared storage is not valid after unshare()
+        if (shared(jobject_))
+        {
+            unshare();
+            it = jobject_->find(key);
+        }
+
+        jobject_->erase(it);
+        return true;
+    }
+
+private:
+    // private static help function - parse token into json object 
+    static bool jobject(std::queue<JsonTokenW>& tokens, Object& jobject)
+    {
+        // Object must start with LeftCurlyBracket:'{' and minimum size is 2 '{' + '}'
+        if (tokens.size() < 2 ||
+            tokens.front().type() != JsonTokenW::Type::LeftCurlyBracket)
+        {
+            return false;
+        }
+        tokens.pop();
 
-                if (character != L'.')
+        while (!tokens.empty())
+        {
+            String key;
+            switch (tokens.front().type())
+            {
+            case JsonTokenW::Type::RightCurlyBracket:
+                tokens.pop();
+                return true;
+            case JsonTokenW::Type::String:
+                key = Traits::native(tokens.front().wstring());
+                if (key.length() == 0)
                 {
-                    type_ = Type::NumberInteger;
-                    integer_ = 0;
-                    return;
+                    return false;
+                }
+                else if (jobject.count(key) > 0)
+                {
+                    return false; // not allow duplicate key
                 }
 
-                containdot = true;
-                numberstr.push_back(character);
-                ins.get();
-                character = ins.peek();
-            }
+                tokens.pop();
+                if (tokens.empty())
+                {
+                    return false;
+                }
+                else if (tokens.front().type() != JsonTokenW::Type::Colon)
+                {
+                    return false;
+                }
 
-            while (iswdigit(character) || character == L'.' || character == L'e')
-            {
-                // handle .
-                if (character == L'.')
+                tokens.pop();
+                if (tokens.empty())
                 {
-                    if (containdot || numberstr.length() == 0)
-                    {
-                        return;
-                    }
-                    else if (numberstr.length() == 1 && !iswdigit(numberstr.at(0)))
+                    return false;
+                }
+                else
+                {
+                    std::shared_ptr<BasicJsonW> junit = std::make_shared<BasicJsonW>(tokens);
+
+                    if (junit->valid() == false)
                     {
-                        return;
+                        return false;
                     }
                     else
                     {
-                        containdot = true;
+                        jobject[key] = junit;
                     }
                 }
 
-                if (character == L'e' || character == L'E')
+                if (!tokens.empty() && tokens.front().type() == JsonTokenW::Type::Comma)
+                {
+                    // consume comma and expect next key-data set
+                    tokens.pop();
+                }
+
+                break;
+            case JsonTokenW::Type::LeftCurlyBracket:
+            case JsonTokenW::Type::LeftSquareBracket:
+            case JsonTokenW::Type::RightSquareBracket:
+            case JsonTokenW::Type::NumberInteger:
+            case JsonTokenW::Type::NumberFloat:
+            case JsonTokenW::Type::Boolean:
+            case JsonTokenW::Type::Null:
+            case JsonTokenW::Type::Colon:
+            case JsonTokenW::Type::Comma:
+            case JsonTokenW::Type::Bad:
+            default:
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    // private static help function - parse tokens into json array
+    static bool jarray(std::queue<JsonTokenW>& tokens, std::vector<std::shared_ptr<BasicJsonW>>& jarray)
+    {
+        // Object must start with LeftCurlyBracket:'[' and minimum size is 2 '[' + ']'
+        if (tokens.size() < 2 ||
+            tokens.front().type() != JsonTokenW::Type::LeftSquareBracket)
+        {
+            return false;
+        }
+        tokens.pop();
+
+        while (!tokens.empty())
+        {
+            switch (tokens.front().type())
+            {
+            case JsonTokenW::Type::RightSquareBracket:
+                tokens.pop();
+                return true;
+            case JsonTokenW::Type::LeftCurlyBracket:
+            case JsonTokenW::Type::LeftSquareBracket:
+            case JsonTokenW::Type::NumberInteger:
+            case JsonTokenW::Type::NumberFloat:
+            case JsonTokenW::Type::Boolean:
+            case JsonTokenW::Type::String:
+            case JsonTokenW::Type::Null:
+            {
+                std::shared_ptr<BasicJsonW> junit = std::make_shared<BasicJsonW>(tokens);
+                if (junit->valid() == false)
+                {
+                    return false;
+                }
+
+                jarray.push_back(junit);
+
+                // if followed by comma, continually read next JsonUnitW
+                if (!tokens.empty() && tokens.front().type() == JsonTokenW::Type::Comma)
                 {
-                    containexp = true;
-                    break;
+                    tokens.pop();
+                    continue;
+                }
+                else if (!tokens.empty() && tokens.front().type() == JsonTokenW::Type::RightSquareBracket)
+                {
+                    tokens.pop();
+                    return true;
+                }
+                else
+                {
+                    return false;
                 }
-
-                numberstr.push_back(character);
-                ins.get();
-                character = ins.peek();
             }
 
-            // last character in numberstr has to be a digit
-            if (numberstr.length() == 0 || !iswdigit(numberstr.back()))
-            {
-                return;
+            // invalid
+            case JsonTokenW::Type::RightCurlyBracket:
+            case JsonTokenW::Type::Colon:
+            case JsonTokenW::Type::Comma:
+            case JsonTokenW::Type::Bad:
+            default:
+                return false;
             }
+        }
 
-            // first digit cannot be zero except frac or zero
-            if (!containdot && numberstr.at(0) == L'0' && numberstr.length() > 1)
-            {
-                return;
-            }
+        return false;
+    }
+    
+    // private static help function - create an empty node, from arena if
+    // it is not null
+    static std::shared_ptr<BasicJsonW> node(const std::shared_ptr<JsonArenaW>& arena)
+    {
+        if (arena)
+        {
+            return std::allocate_shared<BasicJsonW>(JsonArenaAllocatorW<BasicJsonW>(arena));
+        }
 
-            // handle exponent notation
-            if (character == L'e' || character == L'E')
-            {
-                ins.get();
-                character = ins.peek();
-                if (character == L'-')
-                {
-                    negativeexp = true;
-                    ins.get();
-                    character = ins.peek();
-                }
+        return std::make_shared<BasicJsonW>();
+    }
 
-                if (character == L'+')
+    // private static help function - parse text into json object in single pass
+    template <typename TextT>
+    static bool jobject(const TextT*& cur, const TextT* end, Object& jobject,
+        const JsonOptionsW& options, const std::shared_ptr<Source>& source)
+    {
+        // Object must start with LeftCurlyBracket:'{'
+        if (cur >= end || *cur != '{')
+        {
+            return false;
+        }
+        cur++;
+
+        // buffer of key text, reused by all members
+        String key;
+
+        while (JsonTokenW::skip(cur, end))
+        {
+            switch (*cur)
+            {
+            case '}':
+                cur++;
+                return jobject.finish(); // not allow duplicate key
+            case '\"':
+                key.clear();
+                if (!JsonTokenW::scanstring(cur, end, key))
                 {
-                    ins.get();
-                    character = ins.peek();
+                    return false;
                 }
-
-                while (iswdigit(character))
+                else if (key.length() == 0)
                 {
-                    expstr.push_back(character);
-                    ins.get();
-                    character = ins.peek();
+                    return false;
                 }
 
-                if (expstr.length() == 0)
+                if (!JsonTokenW::skip(cur, end) || *cur != ':')
                 {
-                    return;
+                    return false;
                 }
 
-                try
+                cur++;
+                if (!JsonTokenW::skip(cur, end))
                 {
-                    exponent = std::stoi(expstr);
+                    return false;
                 }
-                catch (const std::out_of_range& oor)
+                else
                 {
-                    std::cerr << "Out of Range error: " << oor.what() << '\n';
-                    type_ = Type::Bad;
-                    return;
-                }
-            }
+                    std::shared_ptr<BasicJsonW> junit = value(cur, end, options, source);
 
-            if (containdot)
-            {
-                try
-                {
-                    frac_ = std::stold(numberstr);
+                    if (junit->valid() == false)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        jobject.append(std::make_pair(
+                            options.keys ? options.keys->intern(key) : Key(key), junit));
+                    }
                 }
-                catch (const std::out_of_range&)
+
+                if (JsonTokenW::skip(cur, end) && *cur == ',')
                 {
-                    type_ = Type::Bad;
-                    return;
+                    // consume comma and expect next key-data set
+                    cur++;
                 }
 
-                type_ = Type::NumberFloat;
+                break;
+            default:
+                return false;
             }
-            else
+        }
+
+        return false;
+    }
+
+    // private static help function - parse text into json array in single pass
+    template <typename TextT>
+    static bool jarray(const TextT*& cur, const TextT* end, std::vector<std::shared_ptr<BasicJsonW>>& jarray,
+        const JsonOptionsW& options, const std::shared_ptr<Source>& source)
+    {
+        // Array must start with LeftSquareBracket:'['
+        if (cur >= end || *cur != '[')
+        {
+            return false;
+        }
+        cur++;
+
+        while (JsonTokenW::skip(cur, end))
+        {
+            switch (*cur)
             {
-                try
-                {
-                    integer_ = std::stoll(numberstr);
-                }
-                catch (const std::out_of_range&)
+            case ']':
+                cur++;
+                return true;
+            case '}':
+            case ':':
+            case ',':
+                return false;
+            default:
+            {
+                std::shared_ptr<BasicJsonW> junit = value(cur, end, options, source);
+                if (junit->valid() == false)
                 {
-                    type_ = Type::Bad;
-                    return;
+                    return false;
                 }
 
-                type_ = Type::NumberInteger;
-            }
+                jarray.push_back(junit);
 
-            if (containexp)
-            {
-                double multiplier;
-                if (negativeexp)
+                // if followed by comma, continually read next JsonUnitW
+                if (JsonTokenW::skip(cur, end) && *cur == ',')
                 {
-                    multiplier = std::pow(10, -1 * exponent);
+                    cur++;
+                    continue;
                 }
-                else
+                else if (cur < end && *cur == ']')
                 {
-                    multiplier = std::pow(10, exponent);
+                    cur++;
+                    return true;
                 }
-
-                if (multiplier == HUGE_VAL || multiplier == -HUGE_VAL)
+                else
                 {
-                    std::cerr << "Out of Range error" << std::endl;
-                    type_ = Type::Bad;
-                    return;
+                    return false;
                 }
+            }
+            }
+        }
 
-                if (type_ == Type::NumberInteger)
-                {
-                    frac_ = 1.0 * integer_;
-                    type_ = Type::NumberFloat;
-                }
+        return false;
+    }
 
-                frac_ = frac_ * multiplier;
-            }
+    // private static help function - parse member or element value at
+    // 'cur', object and array are deferred if 'source' is not null
+    template <typename TextT>
+    static std::shared_ptr<BasicJsonW> value(const TextT*& cur, const TextT* end,
+        const JsonOptionsW& options, const std::shared_ptr<Source>& source)
+    {
+        std::shared_ptr<BasicJsonW> junit = node(options.arena);
+
+        if (source && (*cur == '{' || *cur == '['))
+        {
+            junit->defer(cur, end, source);
+        }
+        else
+        {
+            junit->parse(cur, end, options);
+        }
 
+        return junit;
+    }
+
+    // private help function - keep the object or array at 'cur' as text
+    // and move 'cur' past it. Only quotes and brackets are checked here,
+    // the rest is checked when it is parsed by expand().
+    template <typename TextT>
+    void defer(const TextT*& cur, const TextT* end, const std::shared_ptr<Source>& source)
+    {
+        clean(BAD);
+        valid_ = false;
+
+        const TextT* close = match<TextT>(cur, end, nullptr);
+        if (close == nullptr || *close != (*cur == '{' ? '}' : ']'))
+        {
             return;
         }
 
-        // handle 'true'
-        if (character == L't')
+        type_ = *cur == '{' ? OBJECT : ARRAY;
+        valid_ = true;
+        deferred_ = true;
+        lazy_ = new Lazy();
+        lazy_->source = source;
+        lazy_->begin = cur;
+        lazy_->end = close + 1;
+
+        cur = close + 1;
+    }
+
+    // private help function - parse deferred object or array in place, its
+    // own object and array members are deferred again. The value becomes
+    // invalid if the text is malformed. Storage holding deferred values
+    // is DEFERRED and not shared by copies, see held().
+    void expand() const
+    {
+        if (deferred_)
         {
-            ins.get();
-            character = ins.peek();
-            if (character == std::char_traits<wchar_t>::eof() || character != L'r')
-            {
-                return;
-            }
+            const_cast<BasicJsonW*>(this)->materialize();
+        }
+    }
 
-            ins.get();
-            character = ins.peek();
-            if (character == std::char_traits<wchar_t>::eof() || character != L'u')
-            {
-                return;
-            }
+    void materialize()
+    {
+        std::unique_ptr<Lazy> lazy(lazy_);
+        deferred_ = false;
+        type_ = NULLVALUE;
 
-            ins.get();
-            character = ins.peek();
-            if (character == std::char_traits<wchar_t>::eof() || character != L'e')
-            {
-                return;
-            }
+        if (lazy->source->wide)
+        {
+            const wchar_t* cur = static_cast<const wchar_t*>(lazy->begin);
+            parse(cur, static_cast<const wchar_t*>(lazy->end), lazy->source->options, lazy->source);
+        }
+        else
+        {
+            const char* cur = static_cast<const char*>(lazy->begin);
+            parse(cur, static_cast<const char*>(lazy->end), lazy->source->options, lazy->source);
+        }
+    }
 
-            ins.get();
-            type_ = Type::Boolean;
-            boolean_ = true;
-            return;
+    // private help function - parse top-level array at 'cur' by threads.
+    // The elements are split by a pre-scan of quotes and brackets, then
+    // chunks of elements are taken by threads in turn. Each element must
+    // end at the ',' or ']' found by the pre-scan, so the result is the
+    // same as parse(). Return false without change if the text is not a
+    // large array or any element fails, caller parses it in single pass.
+    template <typename TextT>
+    bool parallel(const TextT*& cur, const TextT* end, const JsonOptionsW& options)
+    {
+#if !defined(OCTILLION_JSONW_DISABLE_THREAD)
+        size_t threads = options.threads;
+        if (threads == 0)
+        {
+            threads = std::max(1U, std::thread::hardware_concurrency());
         }
 
-        // handle 'false'
-        if (character == L'f')
+        const TextT* open = cur;
+        if (threads < 2 || (size_t)(end - cur) < JsonOptionsW::PARALLEL_SIZE ||
+            !JsonTokenW::skip(open, end) || *open != '[')
         {
-            ins.get();
-            character = ins.peek();
-            if (character == std::char_traits<wchar_t>::eof() || character != L'a')
-            {
-                return;
-            }
+            return false;
+        }
 
-            ins.get();
-            character = ins.peek();
-            if (character == std::char_traits<wchar_t>::eof() || character != L'l')
-            {
-                return;
-            }
+        // element i ends at stops[i], which is ',' or the closing ']'
+        std::vector<const TextT*> stops;
+        const TextT* close = match(open, end, &stops);
+        if (close == nullptr || *close != ']')
+        {
+            return false;
+        }
 
-            ins.get();
-            character = ins.peek();
-            if (character == std::char_traits<wchar_t>::eof() || character != L's')
-            {
-                return;
-            }
+        // empty element is only allowed after the last ',' or in "[]"
+        const TextT* last = stops.size() > 1 ? stops[stops.size() - 2] + 1 : open + 1;
+        if (!JsonTokenW::skip(last, close))
+        {
+            stops.pop_back();
+        }
 
-            ins.get();
-            character = ins.peek();
-            if (character == std::char_traits<wchar_t>::eof() || character != L'e')
+        // chunk i has elements [chunks[i], chunks[i + 1])
+        std::vector<size_t> chunks(1, 0);
+        const TextT* mark = open;
+        for (size_t i = 0; i < stops.size(); i++)
+        {
+            if ((size_t)(stops[i] - mark) >= JsonOptionsW::PARALLEL_CHUNK)
             {
-                return;
+                chunks.push_back(i + 1);
+                mark = stops[i];
             }
+        }
+        if (chunks.back() != stops.size())
+        {
+            chunks.push_back(stops.size());
+        }
 
-            ins.get();
-            type_ = Type::Boolean;
-            boolean_ = false;
-            return;
+        if (chunks.size() < 3)
+        {
+            return false;
         }
 
-        // handle 'null'
-        if (character == L'n')
+        std::vector<std::shared_ptr<BasicJsonW>> jarray(stops.size());
+        std::atomic<size_t> next(0);
+        std::atomic<bool> failed(false);
+
+        auto work = [&]()
         {
-            ins.get();
-            character = ins.peek();
-            if (character == std::char_traits<wchar_t>::eof() || character != L'u')
+            // worker has no arena and interns keys in its own pool
+            JsonOptionsW local = options;
+            local.threads = 1;
+            local.arena.reset();
+            if (local.keys)
             {
-                return;
+                local.keys = std::make_shared<JsonKeyPoolW>();
             }
 
-            ins.get();
-            character = ins.peek();
-            if (character == std::char_traits<wchar_t>::eof() || character != L'l')
+            size_t chunk;
+            while (!failed && (chunk = next++) + 1 < chunks.size())
             {
-                return;
-            }
+                for (size_t i = chunks[chunk]; i < chunks[chunk + 1]; i++)
+                {
+                    const TextT* text = i == 0 ? open + 1 : stops[i - 1] + 1;
+                    std::shared_ptr<BasicJsonW> junit = node(local.arena);
+                    junit->parse(text, end, local);
 
-            ins.get();
-            character = ins.peek();
-            if (character == std::char_traits<wchar_t>::eof() || character != L'l')
-            {
-                return;
+                    if (!junit->valid() || !JsonTokenW::skip(text, end) || text != stops[i])
+                    {
+                        failed = true;
+                        return;
+                    }
+
+                    jarray[i] = junit;
+                }
             }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < threads && i + 1 < chunks.size(); i++)
+        {
+            workers.push_back(std::thread(work));
+        }
 
-            ins.get();
-            type_ = Type::Null;
-            return;
+        work();
+
+        for (auto& worker : workers)
+        {
+            worker.join();
         }
 
-        // the only remaining possible token is string, must start with \"
-        if (character != L'\"')
+        if (failed)
         {
-            return;
+            return false;
         }
 
-        // consume \"
-        ins.get();
-        character = ins.peek();
+        clean(ARRAY);
+        jarray_->swap(jarray);
+        cur = close + 1;
+        return true;
+#else
+        (void)cur;
+        (void)end;
+        (void)options;
+        return false;
+#endif
+    }
 
-        // handle string
-        bool backslash = false;
-        std::wstring strbuf;
+    // private static help function - find the bracket that closes the
+    // object or array at 'cur' by quotes and brackets only, the text is
+    // not validated. The ',' between elements and the closing bracket are
+    // added to 'stops' if it is not null. Return nullptr if not closed.
+    template <typename TextT>
+    static const TextT* match(const TextT* cur, const TextT* end, std::vector<const TextT*>* stops)
+    {
+        size_t depth = 0;
 
-        while (character != std::char_traits<wchar_t>::eof())
+        for (; cur < end; cur++)
         {
-            if (backslash)
+            switch (*cur)
             {
-                // previous character is backslash
-                if (character == L'u')
+            case '\"':
+            {
+                // string ends at the '\"' after even number of '\\'
+                const TextT* begin = ++cur;
+                for (; ; cur++)
                 {
-                    // special case for \u
-                    std::wstring hexbuf(L"0x");
-                    ins.get();
-                    hexbuf.push_back(ins.get());
-                    hexbuf.push_back(ins.get());
-                    hexbuf.push_back(ins.get());
-                    hexbuf.push_back(ins.get());
-
-                    if (hexbuf.at(2) == std::char_traits<wchar_t>::eof() ||
-                        hexbuf.at(3) == std::char_traits<wchar_t>::eof() ||
-                        hexbuf.at(4) == std::char_traits<wchar_t>::eof() ||
-                        hexbuf.at(5) == std::char_traits<wchar_t>::eof())
+                    cur = std::char_traits<TextT>::find(cur, end - cur, '\"');
+                    if (cur == nullptr)
                     {
-                        return;
+                        return nullptr;
                     }
 
-                    try
+                    const TextT* escape = cur;
+                    while (escape > begin && *(escape - 1) == '\\')
                     {
-                        unsigned int charvalue = std::stoul(hexbuf, NULL, 16);
-                        strbuf.push_back((wchar_t)charvalue);
-                        character = ins.peek();
-                        backslash = false;
-                        continue;
+                        escape--;
                     }
-                    catch (const std::invalid_argument&)
+                    if ((cur - escape) % 2 == 0)
                     {
-                        return;
+                        break;
                     }
-                    catch (const std::out_of_range&)
+                }
+                break;
+            }
+            case '[':
+            case '{':
+                depth++;
+                break;
+            case ']':
+            case '}':
+                if (--depth == 0)
+                {
+                    if (stops != nullptr)
                     {
-                        return;
+                        stops->push_back(cur);
                     }
+                    return cur;
                 }
-
-                // other single character cases
-                switch (character)
+                break;
+            case ',':
+                if (depth == 1 && stops != nullptr)
                 {
-                case L'\"': strbuf.push_back(L'\"'); break;
-                case L'\\': strbuf.push_back(L'\\'); break;
-                case L'/': strbuf.push_back(L'/'); break;
-                case L'b':  strbuf.push_back((wchar_t)0x08); break;
-                case L'f':  strbuf.push_back((wchar_t)0x0c); break;
-                case L'n':  strbuf.push_back(L'\n'); break;
-                case L'r':  strbuf.push_back(L'\r'); break;
-                case L't':  strbuf.push_back(L'\t'); break;
+                    stops->push_back(cur);
                 }
-
-                ins.get();
-                character = ins.peek();
-                backslash = false;
-                continue;
+                break;
+            default:
+                break;
             }
-            else if (character == L'\\')
+        }
+
+        return nullptr;
+    }
+
+    // private static help function, write value into 'out' in json format.
+    // 'out' is JsonWriterW for utf8 text, JsonNativeWriterW for the text of
+    // CharT, or JsonCounterW for the length of the text.
+    template <typename Out>
+    static void write_jvalue(Out& out, const BasicJsonW& jvalue, bool singleline = true, size_t level = 0)
+    {
+        jvalue.expand();
+
+        // invalid value, such as malformed text of lazy parse, has no text
+        // and the text of its container is not json either
+        if (jvalue.valid() == false)
+        {
+            out.fail();
+            return;
+        }
+
+        switch (jvalue.type_)
+        {
+        case BasicJsonW::INTEGER:
+            out.integer(jvalue.integer_);
+            break;
+        case BasicJsonW::FLOAT:
+            out.frac(jvalue.frac_);
+            break;
+        case BasicJsonW::BOOLEAN:
+            out.write(jvalue.boolean_ ? "true" : "false", jvalue.boolean_ ? 4 : 5);
+            break;
+        case BasicJsonW::NULLVALUE:
+            out.write("null", 4);
+            break;
+        case BasicJsonW::STRING:
+            out.string(jvalue.string_->data(), jvalue.string_->length());
+            break;
+        case BasicJsonW::OBJECT:
+            if (singleline == false)
             {
-                // special , set flag and fo next round
-                backslash = true;
-                ins.get();
-                character = ins.peek();
-                continue;
+                write_jobject(out, jvalue, level);
+                break;
             }
-            else if (character == L'\r' || character == L'\n')
+
+            out.put('{');
+            for (typename Object::const_iterator first = jvalue.members().begin(), it = first;
+                it != jvalue.members().end() && out.good(); ++it)
             {
-                // unexpected EOL
-                return;
+                if (it != first)
+                {
+                    out.put(',');
+                }
+                out.string(it->first.data(), it->first.length());
+                out.put(':');
+                write_jvalue(out, *(it->second));
             }
-            else if (character == L'\"')
+            out.put('}');
+            break;
+        case BasicJsonW::ARRAY:
+            // short array stays in single line
+            if (singleline == false && measure(jvalue) > 20)
             {
-                ins.get();
-                type_ = Type::String;
-                wstring_ = strbuf;
-                return;
+                write_jarray(out, jvalue, level);
+                break;
             }
-            else
+
+            out.put('[');
+            for (size_t i = 0; i < jvalue.jarray_->size() && out.good(); i++)
             {
-                strbuf.push_back(character);
-                ins.get();
-                character = ins.peek();
+                if (i > 0)
+                {
+                    out.put(',');
+                }
+                write_jvalue(out, *(*jvalue.jarray_)[i]);
             }
+            out.put(']');
+            break;
+        default:
+            break;
         }
-
-        // unexpected EOF
-        return;
     }
 
-public:
-    enum Type type() const { return type_; }
-    int_fast64_t integer() const { return integer_; }
-    long double frac() const { return frac_; }
-    std::wstring wstring() const { return wstring_; }
-    bool boolean() const { return boolean_; }
-
-private:
-    // determine if  character is white space for json
-    static bool isskippable(wchar_t character)
+    // private static help function, write value into 'out' in MessagePack.
+    // Integer takes the shortest form, float is single precision if it
+    // keeps the value. Value that turns out to be invalid and long double
+    // above double range fail the writing.
+    static void write_msgpack(JsonBytesW& out, const BasicJsonW& jvalue)
     {
-        if (character == L' ' || character == L'\r' || character == L'\n' || character == L'\t')
-        {
-            return true;
-        }
-        else
-        {
-            return false;
-        }
-    }
+        jvalue.expand();
 
-    // skip the white space and check if next non-ws is valid 
-    // beginning character for json token
-    static bool findnext(std::wistream& ins)
-    {
-        wchar_t character;
-        if (!ins.good())
+        if (jvalue.valid() == false)
         {
-            return false;
+            out.fail();
+            return;
         }
 
-        character = ins.peek();
-
-        // return false if no more data to read
-        if (character == std::char_traits<wchar_t>::eof())
+        switch (jvalue.type_)
         {
-            return false;
+        case BasicJsonW::INTEGER:
+        {
+            long long integer = jvalue.integer_;
+
+            if (integer >= -32 && integer < 128)
+                out.put((uint8_t)integer);
+            else if (integer >= 0)
+                msgpackhead(out, 0xCC, 0xCF, 1, (uint64_t)integer);
+            else if (integer >= INT8_MIN)
+                out.put(0xD0, (uint64_t)integer, 1);
+            else if (integer >= INT16_MIN)
+                out.put(0xD1, (uint64_t)integer, 2);
+            else if (integer >= INT32_MIN)
+                out.put(0xD2, (uint64_t)integer, 4);
+            else
+                out.put(0xD3, (uint64_t)integer, 8);
+            break;
         }
+        case BasicJsonW::FLOAT:
+            if (!binary(jvalue.frac_))
+            {
+                out.fail();
+                break;
+            }
+            out.frac(0xCA, 0xCB, (double)jvalue.frac_);
+            break;
+        case BasicJsonW::BOOLEAN:
+            out.put(jvalue.boolean_ ? 0xC3 : 0xC2);
+            break;
+        case BasicJsonW::NULLVALUE:
+            out.put(0xC0);
+            break;
+        case BasicJsonW::STRING:
+            msgpackstring(out, jvalue.string_->data(), jvalue.string_->length());
+            break;
+        case BasicJsonW::OBJECT:
+            if (jvalue.jobject_->size() < 16)
+                out.put((uint8_t)(0x80 | jvalue.jobject_->size()));
+            else
+                msgpackhead(out, 0xDE, 0xDF, 2, jvalue.jobject_->size());
 
-        // skip white space 
-        while (isskippable(character))
-        {
-            ins.get();
-            character = ins.peek();
+            for (typename Object::const_iterator it = jvalue.members().begin();
+                it != jvalue.members().end() && out.good(); ++it)
+            {
+                msgpackstring(out, it->first.data(), it->first.length());
+                write_msgpack(out, *(it->second));
+            }
+            break;
+        case BasicJsonW::ARRAY:
+            if (jvalue.jarray_->size() < 16)
+                out.put((uint8_t)(0x90 | jvalue.jarray_->size()));
+            else
+                msgpackhead(out, 0xDC, 0xDD, 2, jvalue.jarray_->size());
 
-            if (character == std::char_traits<wchar_t>::eof())
+            for (size_t i = 0; i < jvalue.jarray_->size() && out.good(); i++)
             {
-                return false;
+                write_msgpack(out, *(*jvalue.jarray_)[i]);
             }
+            break;
+        default:
+            break;
         }
+    }
 
-        // check next character is valid begin character for token 
-        if (character == L'[' || character == L']' ||
-            character == L'{' || character == L'}' ||
-            character == L':' || iswdigit(character) ||
-            character == L',' || character == L'\"' ||
-            character == L'-' || character == L't' ||
-            character == L'f' || character == L'n')
+    // private static help function, false if a finite long double is above
+    // double range, it has no MessagePack or CBOR form. Infinity is written
+    // as it is.
+    static bool binary(long double frac)
+    {
+        return !std::isfinite(frac) || std::isfinite((double)frac);
+    }
+
+    // private static help function, MessagePack prefix in [first, last]
+    // followed by 'value' in the fewest bytes. 'first' takes 'length' bytes
+    // and every next prefix takes twice the bytes.
+    static void msgpackhead(JsonBytesW& out, uint8_t first, uint8_t last, size_t length, uint64_t value)
+    {
+        for (uint8_t prefix = first; prefix <= last; prefix++, length *= 2)
         {
-            return true;
+            if (length == 8 || (value >> (length * 8)) == 0)
+            {
+                out.put(prefix, value, length);
+                return;
+            }
         }
+
+        throw std::length_error("msgpack");
+    }
+
+    template <typename T>
+    static void msgpackstring(JsonBytesW& out, const T* text, size_t length)
+    {
+        size_t bytes = JsonBytesW::utf8length(text, length);
+
+        if (bytes < 32)
+            out.put((uint8_t)(0xA0 | bytes));
         else
-        {
-            return false;
-        }
+            msgpackhead(out, 0xD9, 0xDB, 1, bytes);
+
+        out.utf8(text, length, bytes);
     }
 
-public:
-    // parse text data from wistream and store tokens in queue
-    static bool parse(std::wistream& ins, std::queue<JsonTokenW>& tokens)
+    // private static help function, write value into 'out' in CBOR with
+    // definite length. Integer and float are written and fail as
+    // write_msgpack() does.
+    static void write_cbor(JsonBytesW& out, const BasicJsonW& jvalue)
     {
-        bool success = findnext(ins);
+        jvalue.expand();
 
-        while (success)
+        if (jvalue.valid() == false)
         {
-            JsonTokenW token(ins);
+            out.fail();
+            return;
+        }
 
-            if (token.type() == JsonTokenW::Type::Bad)
+        switch (jvalue.type_)
+        {
+        case BasicJsonW::INTEGER:
+            if (jvalue.integer_ >= 0)
+                cborhead(out, 0, (uint64_t)jvalue.integer_);
+            else
+                cborhead(out, 1, (uint64_t)(-1 - jvalue.integer_));
+            break;
+        case BasicJsonW::FLOAT:
+            if (!binary(jvalue.frac_))
             {
-                std::queue<JsonTokenW>().swap(tokens); // clear
-                return false;
+                out.fail();
+                break;
             }
-            else
+            out.frac(0xFA, 0xFB, (double)jvalue.frac_);
+            break;
+        case BasicJsonW::BOOLEAN:
+            out.put(jvalue.boolean_ ? 0xF5 : 0xF4);
+            break;
+        case BasicJsonW::NULLVALUE:
+            out.put(0xF6);
+            break;
+        case BasicJsonW::STRING:
+            cborstring(out, jvalue.string_->data(), jvalue.string_->length());
+            break;
+        case BasicJsonW::OBJECT:
+            cborhead(out, 5, jvalue.jobject_->size());
+            for (typename Object::const_iterator it = jvalue.members().begin();
+                it != jvalue.members().end() && out.good(); ++it)
             {
-                tokens.push(token);
+                cborstring(out, it->first.data(), it->first.length());
+                write_cbor(out, *(it->second));
             }
-
-            success = findnext(ins);
+            break;
+        case BasicJsonW::ARRAY:
+            cborhead(out, 4, jvalue.jarray_->size());
+            for (size_t i = 0; i < jvalue.jarray_->size() && out.good(); i++)
+            {
+                write_cbor(out, *(*jvalue.jarray_)[i]);
+            }
+            break;
+        default:
+            break;
         }
-        return true;
     }
 
-private:
-    enum Type type_ = Type::Bad;
-    int_fast64_t integer_ = 0;
-    long double frac_ = 0.0;
-    std::wstring wstring_;
-    bool boolean_ = true;
-};
+    // private static help function, CBOR initial byte of 'major' type and
+    // its argument 'value' in the shortest form
+    static void cborhead(JsonBytesW& out, uint8_t major, uint64_t value)
+    {
+        uint8_t initial = (uint8_t)(major << 5);
+
+        if (value < 24)
+            out.put((uint8_t)(initial | value));
+        else if (value <= 0xFF)
+            out.put(initial | 24, value, 1);
+        else if (value <= 0xFFFF)
+            out.put(initial | 25, value, 2);
+        else if (value <= 0xFFFFFFFFULL)
+            out.put(initial | 26, value, 4);
+        else
+            out.put(initial | 27, value, 8);
+    }
 
-// JsonW is one and the only one class that caller should access. It
-// represents a json 'value' defined in json standard. In other words,
-// JsonW could be a number, a string, a boolean, a null, a json array or
-// an json object. See README.md for the usage.
-class JsonW
-{
-public:
-    // type of jsonw
-    const static int BAD = 0;
-    const static int OBJECT = 1;    
-    const static int ARRAY  = 2;
-    const static int INTEGER  = 3;
-    const static int FLOAT = 4;
-    const static int STRING = 5;
-    const static int BOOLEAN = 6;
-    const static int NULLVALUE = 7;
+    template <typename T>
+    static void cborstring(JsonBytesW& out, const T* text, size_t length)
+    {
+        size_t bytes = JsonBytesW::utf8length(text, length);
+        cborhead(out, 3, bytes);
+        out.utf8(text, length, bytes);
+    }
 
-public:
-    // construtor and destructor
-    // 1. default constructor - NULL value
-    // 2. copy constructor - deep copy
-    // 3. construct by utf8 file input stream 
-    // 4. construct by utf8 string (std::string / const char*)
-    // 5. construct by ucs string (std::wstring / const wchar_t*)
-    // 6. construct by a sequence of token (JsonTokenW)
-    // 7. destrcutor that calls help function clean()
-    JsonW()
+    // private static help function, read 'length' bytes big endian number
+    static bool bigendian(const uint8_t*& cur, const uint8_t* end, size_t length, uint64_t& value)
     {
-        type_ = NULLVALUE;
-        valid_ = true;
+        if ((size_t)(end - cur) < length)
+        {
+            return false;
+        }
+
+        value = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            value = (value << 8) | *cur++;
+        }
+        return true;
     }
 
-    explicit JsonW(const JsonW& rhs)
+    // private static help function, append 'length' bytes utf8 text at
+    // 'cur' to 'str'
+    static bool utf8text(const uint8_t*& cur, const uint8_t* end, uint64_t length, String& str)
     {
-        copy(rhs);
+        if (length > (uint64_t)(end - cur))
+        {
+            return false;
+        }
+
+        const char* text = reinterpret_cast<const char*>(cur);
+        cur += length;
+
+        str.reserve(str.length() + (size_t)length);
+        return JsonTokenW::scanutf8(text, text + length, str);
     }
 
-    explicit JsonW(std::ifstream& fin)
+    // nesting limit of decoded objects and arrays, the decoder recurses
+    // once per level and deeper data is rejected before the stack runs out
+    const static size_t BINARY_DEPTH = 512;
+
+    // private help function, read one MessagePack value at 'cur' into this
+    // node. 'key' is the buffer of key text reused by all members, 'depth'
+    // is the number of objects and arrays around the value.
+    bool msgpack(const uint8_t*& cur, const uint8_t* end, String& key, size_t depth)
     {
-        if (!fin.good())
+        if (cur >= end || depth > BINARY_DEPTH)
         {
-            return;
+            return false;
         }
 
-        // convert to std::string
-        std::string utf8str(
-            (std::istreambuf_iterator<char>(fin)),
-            (std::istreambuf_iterator<char>()));
+        uint8_t prefix = *cur;
+        uint64_t value;
 
-        // convert to wstring
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        std::wstring wstr = conv.from_bytes(utf8str);
+        // fixint, fixmap, fixarray and fixstr keep the value in prefix
+        if (prefix < 0x80 || prefix >= 0xE0)
+        {
+            cur++;
+            type_ = INTEGER;
+            integer_ = (int8_t)prefix;
+            return true;
+        }
+        else if (prefix < 0x90)
+        {
+            cur++;
+            return msgpackobject(cur, end, prefix & 0x0F, key, depth);
+        }
+        else if (prefix < 0xA0)
+        {
+            cur++;
+            return msgpackarray(cur, end, prefix & 0x0F, key, depth);
+        }
+        else if (prefix < 0xC0)
+        {
+            clean(STRING);
+            return msgpackstring(cur, end, *string_);
+        }
 
-        // convert to wstringbuf
-        std::wstringbuf strBuf(wstr.data());
+        cur++;
 
-        // convert to wistream
-        std::wistream wins(&strBuf);
+        switch (prefix)
+        {
+        case 0xC0:
+            type_ = NULLVALUE;
+            return true;
+        case 0xC2:
+        case 0xC3:
+            type_ = BOOLEAN;
+            boolean_ = prefix == 0xC3;
+            return true;
+        case 0xCA:
+        case 0xCB:
+            if (!bigendian(cur, end, prefix == 0xCA ? 4 : 8, value))
+            {
+                return false;
+            }
+            type_ = FLOAT;
+            frac_ = prefix == 0xCA ? single(value) : dual(value);
+            return true;
+        case 0xCC: case 0xCD: case 0xCE: case 0xCF:
+            if (!bigendian(cur, end, (size_t)1 << (prefix - 0xCC), value) ||
+                value > (uint64_t)std::numeric_limits<long long>::max())
+            {
+                return false;
+            }
+            type_ = INTEGER;
+            integer_ = (long long)value;
+            return true;
+        case 0xD0: case 0xD1: case 0xD2: case 0xD3:
+        {
+            size_t length = (size_t)1 << (prefix - 0xD0);
+            if (!bigendian(cur, end, length, value))
+            {
+                return false;
+            }
 
-        // constructor with std::wstring parameter
-        init(wins);
+            // sign extension of 'length' bytes
+            uint64_t sign = (uint64_t)1 << (length * 8 - 1);
+            type_ = INTEGER;
+            integer_ = (long long)((value ^ sign) - sign);
+            return true;
+        }
+        case 0xD9: case 0xDA: case 0xDB:
+            cur--;
+            clean(STRING);
+            return msgpackstring(cur, end, *string_);
+        case 0xDC: case 0xDD:
+            return bigendian(cur, end, prefix == 0xDC ? 2 : 4, value) &&
+                msgpackarray(cur, end, value, key, depth);
+        case 0xDE: case 0xDF:
+            return bigendian(cur, end, prefix == 0xDE ? 2 : 4, value) &&
+                msgpackobject(cur, end, value, key, depth);
+        default:
+            // binary, extension and never used 0xC1
+            return false;
+        }
     }
 
-    explicit JsonW(const char* utf8str)
+    // private static help function, read MessagePack string at 'cur'
+    static bool msgpackstring(const uint8_t*& cur, const uint8_t* end, String& str)
     {
-        // convert to wstring
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        std::wstring wstr = conv.from_bytes(utf8str);
+        if (cur >= end)
+        {
+            return false;
+        }
 
-        // convert to wstringbuf
-        std::wstringbuf strBuf(wstr.data());
+        uint8_t prefix = *cur++;
+        uint64_t length;
 
-        // convert to wistream
-        std::wistream wins(&strBuf);
+        if (prefix >= 0xA0 && prefix < 0xC0)
+        {
+            length = prefix & 0x1F;
+        }
+        else if (prefix < 0xD9 || prefix > 0xDB ||
+            !bigendian(cur, end, (size_t)1 << (prefix - 0xD9), length))
+        {
+            return false;
+        }
 
-        // constructor with std::wstring parameter
-        init(wins);
+        return utf8text(cur, end, length, str);
     }
 
-    explicit JsonW(const wchar_t* wstr)
+    // private help function, read 'size' MessagePack members into this
+    // node, duplicate key and empty key are not allowed as text does
+    bool msgpackobject(const uint8_t*& cur, const uint8_t* end, uint64_t size, String& key, size_t depth)
     {
-        // convert to wstringbuf
-        std::wstringbuf strBuf(wstr);
-
-        // convert to wistream
-        std::wistream wins(&strBuf);
-
-        // constructor with wistream parameter 
-        init(wins);
-    }
+        // every member takes 2 bytes at least
+        if (size > (uint64_t)(end - cur) / 2)
+        {
+            return false;
+        }
 
-    JsonW(const wchar_t* ucsdata, size_t size)
-    {
-        // convert to std::wstring
-        std::wstring wstr(ucsdata, size);
+        clean(OBJECT);
+        jobject_->reserve((size_t)size);
 
-        // convert to wstringbuf
-        std::wstringbuf strBuf(wstr);
+        for (uint64_t i = 0; i < size; i++)
+        {
+            key.clear();
+            if (!msgpackstring(cur, end, key) || key.length() == 0)
+            {
+                return false;
+            }
 
-        // convert to wistream
-        std::wistream wins(&strBuf);
+            // key buffer is reused by the members of the value
+            Key name(key);
+            std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+            if (!jvalue->msgpack(cur, end, key, depth + 1))
+            {
+                return false;
+            }
+            jobject_->append(std::make_pair(std::move(name), jvalue));
+        }
 
-        // constructor with wistream parameter 
-        init(wins);
+        return jobject_->finish();
     }
 
-    JsonW(const char* utf8data, size_t length)
+    // private help function, read 'size' MessagePack values into this node
+    bool msgpackarray(const uint8_t*& cur, const uint8_t* end, uint64_t size, String& key, size_t depth)
     {
-        // convert to std::string
-        std::string utf8str(utf8data, length);
-
-        // convert to wstring
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        std::wstring wstr = conv.from_bytes(utf8str);
+        // every value takes 1 byte at least
+        if (size > (uint64_t)(end - cur))
+        {
+            return false;
+        }
 
-        // convert to wstringbuf
-        std::wstringbuf strBuf(wstr.data());
+        clean(ARRAY);
+        jarray_->reserve((size_t)size);
 
-        // convert to wistream
-        std::wistream wins(&strBuf);
+        for (uint64_t i = 0; i < size; i++)
+        {
+            std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+            if (!jvalue->msgpack(cur, end, key, depth + 1))
+            {
+                return false;
+            }
+            jarray_->push_back(jvalue);
+        }
 
-        // constructor with std::wstring parameter
-        init(wins);
-    }
-    
-    ~JsonW()
-    {
-        clean();
+        return true;
     }
 
-public:    
-    JsonW(std::queue<JsonTokenW>& tokens)
-    {
-        parse(tokens);
-    }
-    
-private:
-    // read json data from a sequence of tokens
-    void parse(std::queue<JsonTokenW>& tokens)
+    // private help function, read one CBOR value at 'cur' into this node
+    // in the same way as msgpack(), a tag counts as one level of 'depth'
+    bool cbor(const uint8_t*& cur, const uint8_t* end, String& key, size_t depth)
     {
-        clean();
-        type_ = BAD;
+        if (cur >= end || depth > BINARY_DEPTH)
+        {
+            return false;
+        }
 
-        if (tokens.empty())
-            return;
+        uint8_t major = *cur >> 5;
+        uint8_t info = *cur & 0x1F;
+        uint64_t value = 0;
 
-        valid_ = true;
+        if (major == 3)
+        {
+            clean(STRING);
+            return cborstring(cur, end, *string_);
+        }
 
-        switch (tokens.front().type())
+        cur++;
+
+        // simple value and float have no argument
+        if (major == 7)
         {
-        case JsonTokenW::Type::LeftCurlyBracket: // object
-            valid_ = jobject(tokens, jobject_);
-            if (valid_)
+            switch (info)
             {
-                type_ = OBJECT;
+            case 20:
+            case 21:
+                type_ = BOOLEAN;
+                boolean_ = info == 21;
+                return true;
+            case 22: // null
+            case 23: // undefined
+                type_ = NULLVALUE;
+                return true;
+            case 25:
+            case 26:
+            case 27:
+                if (!bigendian(cur, end, (size_t)1 << (info - 24), value))
+                {
+                    return false;
+                }
+                type_ = FLOAT;
+                frac_ = info == 25 ? half(value) : (info == 26 ? single(value) : dual(value));
+                return true;
+            default:
+                return false;
             }
-            return;
-        case JsonTokenW::Type::LeftSquareBracket: // array
-            valid_ = jarray(tokens, jarray_);
-            if (valid_)
+        }
+
+        bool indefinite = info == 31 && (major == 4 || major == 5);
+        if (!indefinite && !cborargument(cur, end, info, value))
+        {
+            return false;
+        }
+
+        switch (major)
+        {
+        case 0:
+        case 1:
+            if (value > (uint64_t)std::numeric_limits<long long>::max())
             {
-                type_ = ARRAY;
+                return false;
             }
-            return;
-        case JsonTokenW::Type::NumberInteger:
             type_ = INTEGER;
-            integer_ = tokens.front().integer();
-            tokens.pop();
-            return;
-        case JsonTokenW::Type::NumberFloat:
-            type_ = FLOAT;
-            frac_ = tokens.front().frac();
-            tokens.pop();
-            return;
-        case JsonTokenW::Type::String:
-            type_ = STRING;
-            wstring_ = tokens.front().wstring();
-            tokens.pop();
-            return;
-        case JsonTokenW::Type::Boolean:
-            type_ = BOOLEAN;
-            boolean_ = tokens.front().boolean();
-            tokens.pop();
-            return;
-        case JsonTokenW::Type::Null:
-            type_ = NULLVALUE;
-            tokens.pop();
-            return;
-        default: // bad token
-            valid_ = false;
-            return;
+            integer_ = major == 0 ? (long long)value : -1 - (long long)value;
+            return true;
+        case 4:
+            return cborarray(cur, end, indefinite, value, key, depth);
+        case 5:
+            return cborobject(cur, end, indefinite, value, key, depth);
+        case 6:
+            // tag is skipped, the tagged value is kept
+            return cbor(cur, end, key, depth + 1);
+        default:
+            // byte string
+            return false;
         }
     }
 
-    // deep copy from another JsonW
-    void copy(const JsonW& rhs)
+    // private static help function, read the argument of CBOR initial byte
+    // that has additional information 'info'
+    static bool cborargument(const uint8_t*& cur, const uint8_t* end, uint8_t info, uint64_t& value)
     {
-        clean();
+        if (info < 24)
+        {
+            value = info;
+            return true;
+        }
+        else if (info < 28)
+        {
+            return bigendian(cur, end, (size_t)1 << (info - 24), value);
+        }
 
-        type_ = rhs.type_;
-        valid_ = rhs.valid_;
-        integer_ = rhs.integer_;
-        frac_ = rhs.frac_;
-        wstring_ = rhs.wstring_;
-        boolean_ = rhs.boolean_;
+        return false;
+    }
 
-        for (const auto& it : rhs.jobject_)
+    // private static help function, read CBOR text string at 'cur'. Text of
+    // indefinite length is joined from its chunks.
+    static bool cborstring(const uint8_t*& cur, const uint8_t* end, String& str)
+    {
+        uint64_t length;
+
+        // tag of text is skipped
+        while (cur < end && (*cur >> 5) == 6)
         {
-            std::wstring name = it.first;
+            uint8_t info = *cur++ & 0x1F;
+            if (!cborargument(cur, end, info, length))
+            {
+                return false;
+            }
+        }
 
-            std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>(*(it.second.get()));
-            jobject_[name] = jvalue;
+        if (cur >= end || (*cur >> 5) != 3)
+        {
+            return false;
         }
 
-        for (const auto& it : rhs.jarray_)
+        uint8_t info = *cur++ & 0x1F;
+        if (info != 31)
         {
-            std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>(*(it.get()));
-            jarray_.push_back(jvalue);
+            return cborargument(cur, end, info, length) && utf8text(cur, end, length, str);
         }
-    }
 
-public:
-    // return false if json data is invalid
-    bool valid() const { return valid_; }
-    
-    // get type of jsonw
-    int type() const { return type_; }
-    
-    //
-    // simple data accessors
-    //
+        // chunk is definite text, 0xFF ends the text
+        while (cur < end && *cur != 0xFF)
+        {
+            info = *cur & 0x1F;
+            if ((*cur++ >> 5) != 3 || info == 31 ||
+                !cborargument(cur, end, info, length) || !utf8text(cur, end, length, str))
+            {
+                return false;
+            }
+        }
 
-    // get the number of data in this json value
-    // for number, string and boolean, return 1
-    // for array, return the number of values inside it
-    // for object, return the number of name-value pairs inside it
-    // others return 0
-    size_t size() const
-    {
-        switch (type_)
+        if (cur >= end)
         {
-        case BAD:
-            return 0;
-        case OBJECT:
-            return jobject_.size();
-        case ARRAY:
-            return jarray_.size();
-        case INTEGER:
-        case FLOAT:
-        case STRING:
-        case BOOLEAN:
-            return 1;
-        case NULLVALUE:
-        default:
-            return 0;
+            return false;
         }
-    }
 
-    long long integer() const { return integer_; }
-    long double frac() const { return frac_; }    
-    std::wstring wstr() const { return wstring_; }
-    std::string str() const
-    {
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        return conv.to_bytes(wstring_);
+        cur++;
+        return true;
     }
-    bool boolean() const { return boolean_; }
 
-    void integer(long long integer)
+    // private help function, read CBOR map into this node. Map of
+    // indefinite length ends with 0xFF.
+    bool cborobject(const uint8_t*& cur, const uint8_t* end, bool indefinite, uint64_t size, String& key, size_t depth)
     {
-        clean();
-        type_ = INTEGER;
-        integer_ = integer;
-    }
+        // every member takes 2 bytes at least
+        if (!indefinite && size > (uint64_t)(end - cur) / 2)
+        {
+            return false;
+        }
 
-    void frac(long double frac)
-    {
-        clean();
-        type_ = FLOAT;
-        frac_ = frac;
-    }
+        clean(OBJECT);
+        if (!indefinite)
+        {
+            jobject_->reserve((size_t)size);
+        }
 
-    void wstr(const std::wstring& wstr)
-    {
-        clean();
-        type_ = STRING;
-        wstring_ = wstr;
+        for (uint64_t i = 0; indefinite || i < size; i++)
+        {
+            if (indefinite && cur < end && *cur == 0xFF)
+            {
+                cur++;
+                break;
+            }
+
+            key.clear();
+            if (!cborstring(cur, end, key) || key.length() == 0)
+            {
+                return false;
+            }
+
+            // key buffer is reused by the members of the value
+            Key name(key);
+            std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+            if (!jvalue->cbor(cur, end, key, depth + 1))
+            {
+                return false;
+            }
+            jobject_->append(std::make_pair(std::move(name), jvalue));
+        }
+
+        return jobject_->finish();
     }
 
-    void wstr(const wchar_t* wstr)
+    // private help function, read CBOR array into this node
+    bool cborarray(const uint8_t*& cur, const uint8_t* end, bool indefinite, uint64_t size, String& key, size_t depth)
     {
-        clean();
-        type_ = STRING;
-        wstring_ = wstr;
-    }
+        // every value takes 1 byte at least
+        if (!indefinite && size > (uint64_t)(end - cur))
+        {
+            return false;
+        }
+
+        clean(ARRAY);
+        if (!indefinite)
+        {
+            jarray_->reserve((size_t)size);
+        }
+
+        for (uint64_t i = 0; indefinite || i < size; i++)
+        {
+            if (indefinite && cur < end && *cur == 0xFF)
+            {
+                cur++;
+                break;
+            }
+
+            std::shared_ptr<BasicJsonW> jvalue = std::make_shared<BasicJsonW>();
+            if (!jvalue->cbor(cur, end, key, depth + 1))
+            {
+                return false;
+            }
+            jarray_->push_back(jvalue);
+        }
 
-    void wstr(const wchar_t* wstr, size_t length)
-    {
-        clean();
-        type_ = STRING;
-        std::wstring usc(wstr, length);
-        wstring_ = usc;
+        return true;
     }
 
-    void str(const std::string& str)
+    // private static help function, float of half, single and double
+    // precision from its bits
+    static double half(uint64_t bits)
     {
-        clean();
-        type_ = STRING;
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        wstring_ = conv.from_bytes(str);
-    }
+        int exponent = (int)((bits >> 10) & 0x1F);
+        double mantissa = (double)(bits & 0x3FF);
+        double value;
+
+        if (exponent == 0)
+            value = std::ldexp(mantissa, -24);
+        else if (exponent != 31)
+            value = std::ldexp(mantissa + 1024, exponent - 25);
+        else
+            value = mantissa == 0 ? std::numeric_limits<double>::infinity() :
+                std::numeric_limits<double>::quiet_NaN();
 
-    void str(const char* str)
-    {
-        clean();
-        type_ = STRING;
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        wstring_ = conv.from_bytes(str);
+        return (bits & 0x8000) ? -value : value;
     }
 
-    void str(const char* str, size_t length)
+    static double single(uint64_t bits)
     {
-        clean();
-        type_ = STRING;
-        std::string utf8(str, length);
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        wstring_ = conv.from_bytes(utf8);
+        uint32_t narrow = (uint32_t)bits;
+        float value;
+        std::memcpy(&value, &narrow, sizeof(value));
+        return value;
     }
 
-    void boolean(bool boolean)
+    static double dual(uint64_t bits)
     {
-        clean();
-        type_ = BOOLEAN;
-        boolean_ = boolean;
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
     }
 
-    void reset()
+    // private static help function, write object into 'out' in multiple
+    // lines json format
+    template <typename Out>
+    static void write_jobject(Out& out, const BasicJsonW& jobject, size_t level, bool addcomma = false)
     {
-        clean();
-    }
+        // deferred object may turn out to be malformed
+        jobject.expand();
+        if (jobject.type_ != OBJECT || jobject.valid() == false)
+        {
+            out.fail();
+            return;
+        }
 
-    void json(const std::string& text)
-    {
-        clean();
+        const Object& members = jobject.members();
+        size_t level_plus = level + 1;
 
-        // convert to wstring
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        std::wstring wstr = conv.from_bytes(text);
+        write_intent(out, level);
+        out.write("{\n", 2);
+
+        size_t i = 0;
+        for (typename Object::const_iterator it = members.begin(); it != members.end() && out.good(); ++it, i++)
+        {
+            bool newline = false;
+            bool comma_in_function = true;
+            const Key& key = it->first;
 
-        // convert to wstringbuf
-        std::wstringbuf strBuf(wstr.data());
+            write_intent(out, level_plus);
+            out.string(key.data(), key.length());
+            out.put(':');
 
-        // convert to wistream
-        std::wistream wins(&strBuf);
+            // 'name : value'
+            // when we need to add newline after ':'
+            // 1. value is json object
+            // 2. value is json array and length + level*4 > 40
+            std::shared_ptr<const BasicJsonW> jvalue = it->second;
+            size_t estimate_size = measure(*jvalue);
 
-        // constructor with std::wstring parameter
-        init(wins);
-    }
+            if ( jvalue->type() == BasicJsonW::OBJECT && jvalue->size() > 1 )
+            {
+                if (jvalue->size() > 1 || estimate_size > 20)
+                {
+                    newline = true;
+                    out.put('\n');
+                }
+            }
+            else if ( jvalue->type() == BasicJsonW::ARRAY )
+            {
+                bool has_object_array = false;
 
-    void json(const char* text)
-    {
-        std::string utf8(text);
-        json(utf8);
-    }
+                for (size_t j = 0; j < jvalue->size(); j++)
+                {
+                    if (jvalue->get(j)->type() == BasicJsonW::ARRAY ||
+                        jvalue->get(j)->type() == BasicJsonW::OBJECT)
+                    {
+                        has_object_array = true;
+                    }
+                }
 
-    void json(const char* text, size_t size)
-    {
-        std::string utf8(text, size);
-        json(utf8);
-    }
+                if (has_object_array || estimate_size > 20 )
+                {
+                    newline = true;
+                    out.put('\n');
+                }
+            }
 
-    //
-    // json object accessor member
-    //
-    
-    // return all available keys in either ucs or utf8 enconding
-    void wkeys(std::vector<std::wstring>& keys) const
-    {
-        auto it = jobject_.begin();
+            if ( newline == false || i == members.size() - 1 )
+            {
+                write_jvalue(out, *jvalue);
 
-        while (it != jobject_.end())
-        {
-            keys.push_back(it->first);
-            it++;
+                if (i < members.size() - 1)
+                {
+                    out.put(',');
+                }
+            }
+            else if (jvalue->type() == BasicJsonW::OBJECT)
+            {
+                comma_in_function = false;
+                write_jobject(out, *jvalue, level_plus, true);
+            }
+            else
+            {
+                comma_in_function = false;
+                write_jarray(out, *jvalue, level_plus, true);
+            }
+
+            if ( comma_in_function )
+            {
+                out.put('\n');
+            }
         }
 
-        return;
+        write_intent(out, level);
+        out.write(addcomma ? "},\n" : "}\n", addcomma ? 3 : 2);
     }
 
-    void keys(std::vector<std::string>& keys) const
+    // private static help function, write array into 'out' in multiple
+    // lines json format
+    template <typename Out>
+    static void write_jarray(Out& out, const BasicJsonW& jarray, size_t level, bool addcomma = false)
     {
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        auto it = jobject_.begin();
+        // deferred array may turn out to be malformed
+        jarray.expand();
+        if (jarray.type_ != ARRAY || jarray.valid() == false)
+        {
+            out.fail();
+            return;
+        }
+
+        size_t size = jarray.size();
+        size_t level_plus = level + 1;
+
+        write_intent(out, level);
+        out.write("[\n", 2);
 
-        while (it != jobject_.end())
+        for (size_t i = 0; i < size && out.good(); i++)
         {
-            keys.push_back(conv.to_bytes(it->first));
-            it++;
+            std::shared_ptr<const BasicJsonW> jvalue = jarray.get(i);
+            size_t estimate_size = measure(*jvalue);
+
+            if (jvalue->type() == BasicJsonW::OBJECT &&
+                ( jvalue->size() > 1 || estimate_size > 20))
+            {
+                write_jobject(out, *jvalue, level_plus, i < size - 1);
+            }
+            else if (jvalue->type() == BasicJsonW::ARRAY && estimate_size > 20 )
+            {
+                write_jarray(out, *jvalue, level_plus, i < size - 1);
+            }
+            else
+            {
+                write_intent(out, level_plus);
+                write_jvalue(out, *jvalue);
+
+                if (i < size - 1)
+                {
+                    out.put(',');
+                }
+                out.put('\n');
+            }
         }
 
-        return;
+        write_intent(out, level);
+        out.write(addcomma ? "],\n" : "]\n", addcomma ? 3 : 2);
     }
 
-    // get json value via specific key, return nullptr if
-    // no such entry or 'this' is not an json object
-    std::shared_ptr<JsonW> get(const std::wstring& wkey) const
+    template <typename Out>
+    static void write_intent(Out& out, size_t level)
     {
-        auto it = jobject_.find(wkey);
-        if (it == jobject_.end())
+        for (size_t i = 0; i < level; i++)
         {
-            return nullptr;
+            out.write("    ", 4);
         }
+    }
 
-        return it->second;
+    // private static help function, number of characters of the single
+    // line text of value, used by the layout of multiple lines text
+    static size_t measure(const BasicJsonW& jvalue)
+    {
+        JsonCounterW counter;
+        write_jvalue(counter, jvalue);
+        return counter.characters();
     }
 
-    std::shared_ptr<JsonW> get(const std::string& key) const
+private:
+    // private help function, release all resource 
+    void clean()
     {
-        // convert to wstring
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        std::wstring wkey = conv.from_bytes(key.data());
-        return get(wkey);
+        clean(NULLVALUE);
     }
-    
-    // delete a name-pair value inside json object by the name
-    // return false if no such value
-    bool erase(std::wstring wkey)
+
+    // private help function, release all resource and become an empty
+    // value of 'type'. String, object and array storage is created here,
+    // object uses 'objects' layout.
+    void clean(int type, int objects = JsonOptionsW::DEFAULT_OBJECT)
     {
-        auto it = jobject_.find(wkey);
-        if (it == jobject_.end())
+        // deferred object or array has no storage yet
+        if (deferred_)
         {
-            return false;
+            delete lazy_;
+            deferred_ = false;
+            type_ = NULLVALUE;
         }
-        
-        jobject_.erase(it);
-        return true;
-    }
-    
-    bool erase(std::string key)
-    {
-        // convert to wstring
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        std::wstring wkey = conv.from_bytes(key.data());
-        return erase(wkey);
-    }
 
-    // set json value using specific key, return false
-    // if key length is 0
-    bool add(std::wstring wkey, std::shared_ptr<JsonW> jvalue)
-    {
-        if (wkey.length() == 0)
+        // storage is deleted with the last copy sharing it
+        switch (type_)
         {
-            return false;
+        case OBJECT:
+            release(jobject_);
+            break;
+        case ARRAY:
+            release(jarray_);
+            break;
+        case STRING:
+            release(string_);
+            break;
+        default:
+            break;
         }
 
-        if (type_ != OBJECT)
+        type_ = type;
+        valid_ = true;
+
+        switch (type)
         {
-            clean();
-            type_ = OBJECT;
+        case OBJECT:
+            jobject_ = create<Object>(objects);
+            break;
+        case ARRAY:
+            jarray_ = create<std::vector<std::shared_ptr<BasicJsonW>>>();
+            break;
+        case STRING:
+            string_ = create<String>();
+            break;
+        default:
+            integer_ = 0;
+            break;
         }
-        
-        auto it = jobject_.find(wkey);
-        jobject_[wkey] = jvalue;
-        return true;
     }
 
-    bool add(std::string key, std::shared_ptr<JsonW> jvalue)
+    // private help function, read json data from utf8 (char) or
+    // ucs (wchar_t) text in single pass. Lazy parse keeps 'owner' as the
+    // owner of text, or a copy of text if it is null.
+    template <typename TextT>
+    void init(const TextT* text, size_t length,
+        const JsonOptionsW& options = JsonOptionsW(),
+        std::shared_ptr<const void> owner = std::shared_ptr<const void>())
     {
-        // convert to wstring
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        std::wstring wkey = conv.from_bytes(key.data());
+        const TextT* cur = text;
+        const TextT* end = text + length;
 
-        return add(wkey, jvalue);
-    }
+        if (options.lazy)
+        {
+            if (!owner)
+            {
+                std::shared_ptr<std::basic_string<TextT>> copy =
+                    std::make_shared<std::basic_string<TextT>>(text, length);
+                cur = copy->data();
+                end = cur + length;
+                owner = copy;
+            }
 
-    bool add(std::wstring wkey, long long integer)
-    {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->integer(integer);
-        return add(wkey, jvalue);
-    }
+            std::shared_ptr<Source> source = std::make_shared<Source>();
+            source->owner = owner;
+            source->wide = std::is_same<TextT, wchar_t>::value;
+            source->options = options;
 
-    bool add(std::wstring wkey, long integer)
-    {
-        return add(wkey, (long long)integer);
+            parse(cur, end, options, source);
+        }
+        // large top-level array is parsed by threads, 'cur' is kept as it
+        // is if the array is not parsed in parallel
+        else if (!parallel(cur, end, options))
+        {
+            parse(cur, end, options);
+        }
+
+        // malformed token after the json value makes the whole text invalid
+        if (valid_ && !JsonTokenW::scantail(cur, end))
+        {
+            clean(BAD);
+            valid_ = false;
+        }
     }
 
-    bool add(std::wstring wkey, int integer)
+private:
+    // private member data, the value is stored in a union tagged by
+    // 'type_'. String, object and array are kept outside the node so a
+    // scalar node is only the tag and one number.
+    int type_ = NULLVALUE;
+    bool valid_ = false;
+
+    // object or array of lazy parse is kept in 'lazy_' until first access
+    bool deferred_ = false;
+
+    union
     {
-        return add(wkey, (long long)integer);
-    }
+        long long integer_ = 0;
+        long double frac_;
+        bool boolean_;
+        String* string_;
+        Object* jobject_;
+        std::vector<std::shared_ptr<BasicJsonW>>* jarray_;
+        Lazy* lazy_;
+    };
 
-    bool add(std::wstring wkey, short integer)
+};
+
+// JsonW stores ucs text (wchar_t), JsonU8 stores utf8 text (char)
+typedef BasicJsonW<wchar_t> JsonW;
+typedef BasicJsonW<char> JsonU8;
+
+// BasicJsonDocumentW parses json text into nodes allocated from its own arena.
+// All nodes are freed together when the document is reset or destroyed,
+// which saves one heap allocation per value for request scoped json. The
+// arena is reused by next parse() after reset() if no node is kept by
+// caller, otherwise a new arena is created and the old one is released
+// with the last node. JsonDocumentW holds JsonW and JsonDocumentU8 holds
+// JsonU8.
+template <typename CharT>
+class BasicJsonDocumentW
+{
+public:
+    // 'objects' is the layout of json object, see JsonOptionsW. Object keys
+    // of all parsed documents are interned in 'keys' if it is not null, the
+    // pool can be shared by documents of the same thread.
+    explicit BasicJsonDocumentW(size_t blocksize = JsonArenaW::DEFAULT_BLOCK_SIZE,
+        int objects = JsonOptionsW::DEFAULT_OBJECT,
+        const std::shared_ptr<JsonKeyPoolW>& keys = std::shared_ptr<JsonKeyPoolW>())
+        : blocksize_(blocksize)
     {
-        return add(wkey, (long long)integer);
+        options_.arena = std::make_shared<JsonArenaW>(blocksize);
+        options_.keys = keys;
+        options_.objects = objects;
     }
 
-    bool add(std::string key, long long integer)
+    BasicJsonDocumentW(const BasicJsonDocumentW&) = delete;
+    BasicJsonDocumentW& operator=(const BasicJsonDocumentW&) = delete;
+
+public:
+    // parse utf8 or ucs json text, the previous root is released
+    bool parse(const char* utf8data, size_t length)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->integer(integer);
-        return add(key, jvalue);
+        reset();
+        root_ = std::allocate_shared<BasicJsonW<CharT>>(JsonArenaAllocatorW<BasicJsonW<CharT>>(options_.arena), utf8data, length, options_);
+        return root_->valid();
     }
 
-    bool add(std::string key, long integer)
+    bool parse(const std::string& utf8str)
     {
-        return add(key, (long long)integer);
+        return parse(utf8str.data(), utf8str.length());
     }
 
-    bool add(std::string key, int integer)
+    bool parse(const wchar_t* ucsdata, size_t size)
     {
-        return add(key, (long long)integer);
+        reset();
+        root_ = std::allocate_shared<BasicJsonW<CharT>>(JsonArenaAllocatorW<BasicJsonW<CharT>>(options_.arena), ucsdata, size, options_);
+        return root_->valid();
     }
 
-    bool add(std::string key, short integer)
+    bool parse(const std::wstring& wstr)
     {
-        return add(key, (long long)integer);
+        return parse(wstr.data(), wstr.length());
     }
 
-    bool add(std::wstring wkey, long double frac)
+    // parse utf8 json file at 'path' in place from a memory mapping
+    bool load(const std::string& path)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->frac(frac);
-        return add(wkey, jvalue);
+        JsonFileW file(path);
+
+        if (!file.good())
+        {
+            reset();
+            return false;
+        }
+
+        return parse(file.data(), file.size());
     }
 
-    bool add(std::wstring wkey, double frac)
+    // root value of the document, null if nothing is parsed
+    std::shared_ptr<BasicJsonW<CharT>> root() const { return root_; }
+
+    // release the document and rewind the arena for next parse
+    void reset()
     {
-        return add(wkey, (long double)frac);
+        root_.reset();
+
+        if (!options_.arena->reset())
+        {
+            options_.arena = std::make_shared<JsonArenaW>(blocksize_);
+        }
     }
 
-    bool add(std::wstring wkey, float frac)
+    const JsonArenaW& arena() const { return *options_.arena; }
+
+    // key pool of the document, null if keys are not interned
+    std::shared_ptr<JsonKeyPoolW> keys() const { return options_.keys; }
+
+private:
+    size_t blocksize_;
+    JsonOptionsW options_;
+    std::shared_ptr<BasicJsonW<CharT>> root_;
+};
+
+typedef BasicJsonDocumentW<wchar_t> JsonDocumentW;
+typedef BasicJsonDocumentW<char> JsonDocumentU8;
+
+// BasicJsonHandlerW receives the events of BasicJsonReaderW. Each callback
+// returns false to stop reading. The default callbacks do nothing, derive
+// from it and override the events of interest. String and key are passed
+// in a buffer reused by reader, copy it if the value is needed later.
+// JsonHandlerW receives std::wstring and JsonHandlerU8 receives utf8
+// std::string.
+template <typename CharT>
+class BasicJsonHandlerW
+{
+public:
+    typedef std::basic_string<CharT> String;
+
+public:
+    virtual ~BasicJsonHandlerW() {}
+
+    virtual bool on_start_object() { return true; }
+    virtual bool on_key(const String& key) { (void)key; return true; }
+    virtual bool on_end_object() { return true; }
+    virtual bool on_start_array() { return true; }
+    virtual bool on_end_array() { return true; }
+    virtual bool on_integer(long long integer) { (void)integer; return true; }
+    virtual bool on_float(long double frac) { (void)frac; return true; }
+    virtual bool on_string(const String& str) { (void)str; return true; }
+    virtual bool on_boolean(bool boolean) { (void)boolean; return true; }
+    virtual bool on_null() { return true; }
+};
+
+typedef BasicJsonHandlerW<wchar_t> JsonHandlerW;
+typedef BasicJsonHandlerW<char> JsonHandlerU8;
+
+class JsonBindW;
+
+// BasicJsonReaderW reads json text with the scanner of JsonTokenW and
+// reports each value to a handler instead of building BasicJsonW nodes, so
+// it runs in constant memory apart from the nesting depth. It accepts the
+// same text as BasicJsonW except that duplicate keys are not detected.
+// Handler is BasicJsonHandlerW or any class with the same callbacks.
+template <typename CharT>
+class BasicJsonReaderW
+{
+public:
+    typedef std::basic_string<CharT> String;
+
+public:
+    // read utf8 or ucs json text, return false if the text is invalid or
+    // handler stops reading. Events before the error are already reported.
+    template <typename Handler>
+    static bool parse(const char* utf8data, size_t length, Handler& handler)
     {
-        return add(wkey, (long double)frac);
+        return read(utf8data, utf8data + length, handler);
     }
 
-    bool add(std::string key, long double frac)
+    template <typename Handler>
+    static bool parse(const std::string& utf8str, Handler& handler)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->frac(frac);
-        return add(key, jvalue);
+        return parse(utf8str.data(), utf8str.length(), handler);
     }
 
-    bool add(std::string key, double frac)
+    template <typename Handler>
+    static bool parse(const wchar_t* ucsdata, size_t size, Handler& handler)
     {
-        return add(key, (long double)frac);
+        return read(ucsdata, ucsdata + size, handler);
     }
 
-    bool add(std::string key, float frac)
+    template <typename Handler>
+    static bool parse(const std::wstring& wstr, Handler& handler)
     {
-        return add(key, (long double)frac);
+        return parse(wstr.data(), wstr.length(), handler);
     }
 
-    bool add(std::wstring wkey, std::wstring wstr)
+    // read utf8 json file in place from a memory mapping, see JsonFileW
+    template <typename Handler>
+    static bool load(const std::string& path, Handler& handler)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->wstr(wstr);
-        return add(wkey, jvalue);
+        JsonFileW file(path);
+        return file.good() && parse(file.data(), file.size(), handler);
     }
 
-    bool add(std::string key, std::string str)
+private:
+    friend class JsonBindW;
+
+    template <typename TextT, typename Handler>
+    static bool read(const TextT* cur, const TextT* end, Handler& handler)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->str(str);
-        return add(key, jvalue);
+        // buffer of string and key, reused by all values
+        String buffer;
+
+        return value(cur, end, handler, buffer) && JsonTokenW::scantail(cur, end);
     }
 
-    bool add(std::wstring wkey, bool boolean )
+    template <typename TextT, typename Handler>
+    static bool value(const TextT*& cur, const TextT* end, Handler& handler, String& buffer)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->boolean(boolean);
-        return add(wkey, jvalue);
+        if (!JsonTokenW::skip(cur, end))
+        {
+            return false;
+        }
+
+        int_fast64_t integer;
+        long double frac;
+
+        switch (*cur)
+        {
+        case '{':
+            return object(cur, end, handler, buffer);
+        case '[':
+            return array(cur, end, handler, buffer);
+        case '\"':
+            buffer.clear();
+            return JsonTokenW::scanstring(cur, end, buffer) && handler.on_string(buffer);
+        case 't':
+            return JsonTokenW::scanliteral(cur, end, "true") && handler.on_boolean(true);
+        case 'f':
+            return JsonTokenW::scanliteral(cur, end, "false") && handler.on_boolean(false);
+        case 'n':
+            return JsonTokenW::scanliteral(cur, end, "null") && handler.on_null();
+        case '-': case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            switch (JsonTokenW::scannumber(cur, end, integer, frac))
+            {
+            case JsonTokenW::Type::NumberInteger:
+                return handler.on_integer(integer);
+            case JsonTokenW::Type::NumberFloat:
+                return handler.on_float(frac);
+            default:
+                return false;
+            }
+        default: // not a valid begin character of json value
+            return false;
+        }
     }
 
-    bool add(std::string key, bool boolean)
+    // same grammar as BasicJsonW::jobject()
+    template <typename TextT, typename Handler>
+    static bool object(const TextT*& cur, const TextT* end, Handler& handler, String& buffer)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->boolean(boolean);
-        return add(key, jvalue);
-    }
+        cur++;
+        if (!handler.on_start_object())
+        {
+            return false;
+        }
+
+        while (JsonTokenW::skip(cur, end))
+        {
+            switch (*cur)
+            {
+            case '}':
+                cur++;
+                return handler.on_end_object();
+            case '\"':
+                buffer.clear();
+                if (!JsonTokenW::scanstring(cur, end, buffer) || buffer.length() == 0)
+                {
+                    return false;
+                }
+
+                if (!JsonTokenW::skip(cur, end) || *cur != ':')
+                {
+                    return false;
+                }
+                cur++;
 
-    //
-    // json array accessors
-    //
+                if (!handler.on_key(buffer) || !value(cur, end, handler, buffer))
+                {
+                    return false;
+                }
 
-    // retrieve the json value in array
-    std::shared_ptr<JsonW> get(size_t idx) const
-    {
-        if (idx >= jarray_.size())
-        {
-            return nullptr;
+                if (JsonTokenW::skip(cur, end) && *cur == ',')
+                {
+                    // consume comma and expect next key-data set
+                    cur++;
+                }
+                break;
+            default:
+                return false;
+            }
         }
 
-        return jarray_.at(idx);
+        return false;
     }
 
-    // add one json value into array
-    bool add(std::shared_ptr<JsonW> junit)
+    // same grammar as BasicJsonW::jarray()
+    template <typename TextT, typename Handler>
+    static bool array(const TextT*& cur, const TextT* end, Handler& handler, String& buffer)
     {
-        if (type_ != ARRAY)
+        cur++;
+        if (!handler.on_start_array())
         {
-            clean();
-            type_ = ARRAY;
+            return false;
         }
 
-        if (junit == nullptr)
+        while (JsonTokenW::skip(cur, end))
         {
-            // NULLVALUE json value
-            jarray_.push_back(std::make_shared<JsonW>());
-        }
-        else
-        {
-            jarray_.push_back(junit);
+            switch (*cur)
+            {
+            case ']':
+                cur++;
+                return handler.on_end_array();
+            case '}':
+            case ':':
+            case ',':
+                return false;
+            default:
+                if (!value(cur, end, handler, buffer))
+                {
+                    return false;
+                }
+
+                // if followed by comma, continually read next value
+                if (JsonTokenW::skip(cur, end) && *cur == ',')
+                {
+                    cur++;
+                    continue;
+                }
+                else if (cur < end && *cur == ']')
+                {
+                    cur++;
+                    return handler.on_end_array();
+                }
+                else
+                {
+                    return false;
+                }
+            }
         }
-        
-        valid_ = true;        
-        return true;
-    }
 
-    bool add(long long integer)
-    {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->integer(integer);
-        return add(jvalue);
+        return false;
     }
+};
 
-    bool add(long integer)
-    {
-        return add((long long)integer);
-    }
+typedef BasicJsonReaderW<wchar_t> JsonReaderW;
+typedef BasicJsonReaderW<char> JsonReaderU8;
 
-    bool add(int integer)
-    {
-        return add((long long)integer);
+// Struct binding. OCTILLION_JSONW_BIND(Type, member, ...) lists the members
+// of a struct that map to the json object members of the same names, up to
+// 64 of them. It is placed in the namespace of Type, after Type is defined.
+// Then JsonBindW reads json text straight into the struct and writes it
+// back without building BasicJsonW nodes.
+//
+//     struct Point { int x; int y; std::string name; std::vector<int> tags; };
+//     OCTILLION_JSONW_BIND(Point, x, y, name, tags)
+//
+// The macro defines jsonw_fields(), which visits every member in order,
+// and jsonw_field(), which finds a member by the FNV-1a hash of its name in
+// a switch on the hashes computed at compile time.
+#define OCTILLION_JSONW_BIND(Type, ...) \
+    template <typename Visitor> \
+    inline bool jsonw_fields(const Type& object, Visitor& visitor) \
+    { \
+        return true OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_CONCAT(OCTILLION_JSONW_FOR_, \
+            OCTILLION_JSONW_COUNT(__VA_ARGS__))(OCTILLION_JSONW_VISIT, __VA_ARGS__)); \
+    } \
+    template <typename Visitor> \
+    inline bool jsonw_field(Type& object, uint32_t hash, Visitor& visitor) \
+    { \
+        switch (hash) \
+        { \
+        OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_CONCAT(OCTILLION_JSONW_FOR_, \
+            OCTILLION_JSONW_COUNT(__VA_ARGS__))(OCTILLION_JSONW_CASE, __VA_ARGS__)) \
+        default: \
+            return false; \
+        } \
     }
 
-    bool add(short integer)
+#define OCTILLION_JSONW_HASH(name) \
+    std::integral_constant<uint32_t, JsonKeyW<char>::literal(#name, sizeof(#name) - 1)>::value
+#define OCTILLION_JSONW_VISIT(name) \
+    && visitor(#name, sizeof(#name) - 1, object.name)
+#define OCTILLION_JSONW_CASE(name) \
+    case OCTILLION_JSONW_HASH(name): return visitor(#name, sizeof(#name) - 1, object.name);
+#define OCTILLION_JSONW_EXPAND(x) x
+#define OCTILLION_JSONW_CONCAT(a, b) OCTILLION_JSONW_CONCAT_(a, b)
+#define OCTILLION_JSONW_CONCAT_(a, b) a##b
+#define OCTILLION_JSONW_COUNT(...) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_NTH(__VA_ARGS__, \
+    64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, \
+    40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, \
+    16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define OCTILLION_JSONW_NTH( \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, \
+    _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, \
+    _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, \
+    _60, _61, _62, _63, _64, N, ...) N
+#define OCTILLION_JSONW_FOR_1(m, f) m(f)
+#define OCTILLION_JSONW_FOR_2(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_1(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_3(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_2(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_4(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_3(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_5(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_4(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_6(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_5(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_7(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_6(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_8(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_7(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_9(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_8(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_10(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_9(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_11(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_10(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_12(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_11(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_13(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_12(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_14(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_13(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_15(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_14(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_16(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_15(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_17(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_16(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_18(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_17(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_19(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_18(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_20(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_19(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_21(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_20(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_22(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_21(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_23(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_22(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_24(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_23(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_25(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_24(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_26(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_25(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_27(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_26(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_28(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_27(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_29(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_28(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_30(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_29(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_31(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_30(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_32(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_31(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_33(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_32(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_34(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_33(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_35(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_34(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_36(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_35(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_37(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_36(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_38(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_37(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_39(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_38(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_40(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_39(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_41(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_40(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_42(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_41(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_43(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_42(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_44(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_43(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_45(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_44(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_46(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_45(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_47(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_46(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_48(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_47(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_49(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_48(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_50(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_49(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_51(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_50(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_52(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_51(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_53(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_52(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_54(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_53(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_55(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_54(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_56(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_55(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_57(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_56(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_58(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_57(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_59(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_58(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_60(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_59(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_61(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_60(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_62(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_61(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_63(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_62(m, __VA_ARGS__))
+#define OCTILLION_JSONW_FOR_64(m, f, ...) m(f) OCTILLION_JSONW_EXPAND(OCTILLION_JSONW_FOR_63(m, __VA_ARGS__))
+
+// JsonBindW reads json text into the structs bound by OCTILLION_JSONW_BIND
+// and writes them as utf8 json text. A member is one of bool, integral and
+// floating point number, std::string (utf8), std::wstring, std::vector of
+// them or another bound struct. The json members not bound are skipped,
+// the bound members not in json or with null value are left unchanged.
+// Integer must fit in the member type, float is not read into integer.
+class JsonBindW
+{
+public:
+    // read utf8 or ucs json text into 'value', return false if the text is
+    // invalid or does not match the types. Members read before the error
+    // are already changed.
+    template <typename T>
+    static bool parse(const char* utf8data, size_t length, T& value)
     {
-        return add((long long)integer);
+        return read(utf8data, utf8data + length, value);
     }
 
-    bool add(long double frac)
+    template <typename T>
+    static bool parse(const std::string& utf8str, T& value)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->frac(frac);
-        return add(jvalue);
+        return parse(utf8str.data(), utf8str.length(), value);
     }
 
-    bool add(double frac)
+    template <typename T>
+    static bool parse(const wchar_t* ucsdata, size_t size, T& value)
     {
-        return add((long double)frac);
+        return read(ucsdata, ucsdata + size, value);
     }
 
-    bool add(float frac)
+    template <typename T>
+    static bool parse(const std::wstring& wstr, T& value)
     {
-        return add((long double)frac);
+        return parse(wstr.data(), wstr.length(), value);
     }
 
-    bool add(std::wstring wstr)
+    // format 'value' into single line utf8 json text, members are written
+    // in the order of OCTILLION_JSONW_BIND
+    template <typename T>
+    static std::string text(const T& value)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->wstr(wstr);
-        return add(jvalue);
+        std::string buffer;
+        write(buffer, value);
+        return buffer;
     }
 
-    bool add(std::string str)
+    // append utf8 json text of 'value' to 'buffer'
+    template <typename T>
+    static void write(std::string& buffer, const T& value)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->str(str);
-        return add(jvalue);
+        JsonWriterW writer(buffer);
+        put(writer, value);
+        writer.flush();
     }
 
-    bool add(bool boolean)
+    // write utf8 json text of 'value' into 'sink', return false if sink
+    // stops the writing
+    template <typename T>
+    static bool write(JsonSinkW& sink, const T& value)
     {
-        std::shared_ptr<JsonW> jvalue = std::make_shared<JsonW>();
-        jvalue->boolean(boolean);
-        return add(jvalue);
+        JsonWriterW writer(sink);
+        put(writer, value);
+        return writer.flush();
     }
-    
-    // delete a value inside json array by index, 
-    // return false if no such value.
-    bool erase(size_t idx)
+
+private:
+    // visitor of jsonw_field(), reads the member if its name is 'key'
+    template <typename TextT>
+    struct Reader
     {
-        if ( type_ != ARRAY )
-        {
-            return false;
-        }
+        const TextT*& cur;
+        const TextT* end;
+        std::string& key;
+        bool good;
 
-        if ( size() <= idx )
+        template <typename Field>
+        bool operator()(const char* name, size_t length, Field& field)
         {
-            return false;
-        }
+            if (key.length() != length || key.compare(0, length, name, length) != 0)
+            {
+                return false;
+            }
 
-        jarray_.erase( jarray_.begin() + idx );
-        
-        return true;
-    }
+            good = value(cur, end, field, key);
+            return true;
+        }
+    };
 
-public:    
-    //
-    // operator overloading
-    //
-    JsonW& operator=(short value)
+    // visitor of jsonw_fields(), writes each member
+    struct Writer
     {
-        clean();
+        JsonWriterW& writer;
+        bool first;
 
-        type_ = INTEGER;
-        valid_ = true;
-        integer_ = value;
-
-        return *this;
-    }
+        template <typename Field>
+        bool operator()(const char* name, size_t length, const Field& field)
+        {
+            writer.put(first ? '{' : ',');
+            writer.string(name, length);
+            writer.put(':');
+            put(writer, field);
+            first = false;
+            return true;
+        }
+    };
 
-    JsonW& operator=(int value)
+    template <typename TextT, typename T>
+    static bool read(const TextT* cur, const TextT* end, T& value)
     {
-        clean();
-
-        type_ = INTEGER;
-        valid_ = true;
-        integer_ = value;
+        // buffer of key, reused by all objects
+        std::string key;
 
-        return *this;
+        return JsonBindW::value(cur, end, value, key) && JsonTokenW::scantail(cur, end);
     }
 
-    JsonW& operator=( long value )
+    // null leaves the value unchanged
+    template <typename TextT, typename T>
+    static bool value(const TextT*& cur, const TextT* end, T& value, std::string& key)
     {
-        clean();
+        if (!JsonTokenW::skip(cur, end))
+        {
+            return false;
+        }
 
-        type_ = INTEGER;
-        valid_ = true;
-        integer_ = value;
+        if (*cur == 'n')
+        {
+            return JsonTokenW::scanliteral(cur, end, "null");
+        }
 
-        return *this;
+        return get(cur, end, value, key, std::is_arithmetic<T>());
     }
 
-    JsonW& operator=(long long value)
-    {
-        clean();
-
-        type_ = INTEGER;
-        valid_ = true;
-        integer_ = value;
-
-        return *this;
-    }
-    
-    JsonW& operator=(long double value)
+    template <typename TextT>
+    static bool get(const TextT*& cur, const TextT* end, bool& value, std::string&, std::true_type)
     {
-        clean();
+        if (JsonTokenW::scanliteral(cur, end, "true"))
+        {
+            value = true;
+            return true;
+        }
 
-        type_ = FLOAT;
-        valid_ = true;
-        frac_ = value;
+        if (JsonTokenW::scanliteral(cur, end, "false"))
+        {
+            value = false;
+            return true;
+        }
 
-        return *this;
+        return false;
     }
 
-    JsonW& operator=(double value)
+    template <typename TextT, typename T>
+    static bool get(const TextT*& cur, const TextT* end, T& value, std::string&, std::true_type)
     {
-        clean();
+        int_fast64_t integer;
+        long double frac;
 
-        type_ = FLOAT;
-        valid_ = true;
-        frac_ = value;
+        if (*cur != '-' && (*cur < '0' || *cur > '9'))
+        {
+            return false;
+        }
 
-        return *this;
+        const TextT* begin = cur;
+
+        switch (JsonTokenW::scannumber(cur, end, integer, frac))
+        {
+        case JsonTokenW::Type::NumberInteger:
+            return number(integer, value, std::is_integral<T>());
+        case JsonTokenW::Type::NumberFloat:
+            // number above the range of the member type is rejected as an
+            // integer out of range is
+            if (!std::is_floating_point<T>::value || !std::isfinite((T)frac))
+            {
+                return false;
+            }
+            value = (T)frac;
+            return true;
+        default:
+            // integer above INT64_MAX does not fit int_fast64_t
+            return std::is_unsigned<T>::value && number(begin, cur, value);
+        }
     }
 
-    JsonW& operator=(float value)
+    template <typename TextT, typename CharT>
+    static bool get(const TextT*& cur, const TextT* end, std::basic_string<CharT>& value, std::string&, std::false_type)
     {
-        clean();
-
-        type_ = FLOAT;
-        valid_ = true;
-        frac_ = value;
-
-        return *this;
+        value.clear();
+        return *cur == '\"' && JsonTokenW::scanstring(cur, end, value);
     }
 
-    JsonW& operator=(const wchar_t* value)
+    // same grammar as BasicJsonW::jarray()
+    template <typename TextT, typename T>
+    static bool get(const TextT*& cur, const TextT* end, std::vector<T>& value, std::string& key, std::false_type)
     {
-        clean();
+        if (*cur != '[')
+        {
+            return false;
+        }
 
-        type_ = STRING;
-        valid_ = true;
-        wstring_ = value;
+        cur++;
+        value.clear();
 
-        return *this;
-    }
-    
-    JsonW& operator=(const std::wstring& value)
-    {
-        clean();
+        while (JsonTokenW::skip(cur, end))
+        {
+            switch (*cur)
+            {
+            case ']':
+                cur++;
+                return true;
+            case '}':
+            case ':':
+            case ',':
+                return false;
+            default:
+            {
+                // element of std::vector<bool> is not a reference, read
+                // into a local value
+                T item = T();
+                if (!JsonBindW::value(cur, end, item, key))
+                {
+                    return false;
+                }
+                value.push_back(std::move(item));
 
-        type_ = STRING;
-        valid_ = true;
-        wstring_ = value;
+                if (JsonTokenW::skip(cur, end) && *cur == ',')
+                {
+                    cur++;
+                    continue;
+                }
+                else if (cur < end && *cur == ']')
+                {
+                    cur++;
+                    return true;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            }
+        }
 
-        return *this;
+        return false;
     }
 
-    JsonW& operator=(const char* value)
+    // bound struct, same grammar as BasicJsonW::jobject(), duplicate key
+    // is rejected as well
+    template <typename TextT, typename T>
+    static bool get(const TextT*& cur, const TextT* end, T& value, std::string& key, std::false_type)
     {
-        clean();
+        if (*cur != '{')
+        {
+            return false;
+        }
 
-        type_ = STRING;
-        valid_ = true;
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        wstring_ = conv.from_bytes(value);
+        cur++;
 
-        return *this;
-    }
+        // keys read so far, small object is scanned and large one hashed
+        JsonObjectW<JsonKeyW<char>, bool> keys(JsonOptionsW::ORDERED);
 
-    JsonW& operator=(std::string value)
-    {
-        clean();
+        while (JsonTokenW::skip(cur, end))
+        {
+            switch (*cur)
+            {
+            case '}':
+                cur++;
+                return true;
+            case '\"':
+            {
+                key.clear();
+                if (!JsonTokenW::scanstring(cur, end, key) || key.length() == 0)
+                {
+                    return false;
+                }
 
-        type_ = STRING;
-        valid_ = true;
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        wstring_ = conv.from_bytes(value.data());
+                if (!JsonTokenW::skip(cur, end) || *cur != ':')
+                {
+                    return false;
+                }
+                cur++;
 
-        return *this;
-    }
-   
-    JsonW& operator=(bool boolean)
-    {
-        clean();
+                JsonKeyW<char> name(key);
+                if (!keys.insert(std::make_pair(name, true)).second)
+                {
+                    return false;
+                }
 
-        type_ = BOOLEAN;
-        valid_ = true;
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        boolean_ = boolean;
+                Reader<TextT> reader = { cur, end, key, false };
+                if (jsonw_field(value, name.hash(), reader))
+                {
+                    if (!reader.good)
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    // json member not bound, check and skip its value
+                    BasicJsonHandlerW<char> handler;
+                    if (!BasicJsonReaderW<char>::value(cur, end, handler, key))
+                    {
+                        return false;
+                    }
+                }
+
+                if (JsonTokenW::skip(cur, end) && *cur == ',')
+                {
+                    // consume comma and expect next key-data set
+                    cur++;
+                }
+                break;
+            }
+            default:
+                return false;
+            }
+        }
 
-        return *this;
-    }    
-        
-    JsonW& operator=(const JsonW& junit)
-    {
-        copy(junit);
-        return *this;
+        return false;
     }
 
-    JsonW& operator[] (size_t index)
+    template <typename T>
+    static bool number(int_fast64_t integer, T& value, std::true_type)
     {
-        if (type_ != ARRAY)
+        if (std::is_signed<T>::value ?
+            (integer < (int_fast64_t)std::numeric_limits<T>::min() || integer > (int_fast64_t)std::numeric_limits<T>::max()) :
+            (integer < 0 || (uint64_t)integer > (uint64_t)std::numeric_limits<T>::max()))
         {
-            clean();
-            type_ = ARRAY;
-            valid_ = true;
+            return false;
         }
 
-        if (index >= size())
-        {
-            for (size_t i = size(); i <= index; i++)
-            {
-                add(std::make_shared<JsonW>());
-            }
-        }
+        value = (T)integer;
+        return true;
+    }
 
-        return *(get(index));
+    template <typename T>
+    static bool number(int_fast64_t integer, T& value, std::false_type)
+    {
+        value = (T)integer;
+        return true;
     }
 
-    JsonW& operator[] (int index)
+    // unsigned integer of text [begin, end) that does not fit int64_t
+    template <typename TextT, typename T>
+    static bool number(const TextT* begin, const TextT* end, T& value)
     {
-        if (index < 0)
-        {
-            return bad();
-        }
+        uint64_t integer = 0;
 
-        if (type_ != ARRAY)
+        if (begin == end || (*begin == '0' && end - begin > 1))
         {
-            clean();
-            type_ = ARRAY;
-            valid_ = true;
+            return false;
         }
 
-        if (index >= (int)size())
+        for (const TextT* cur = begin; cur < end; cur++)
         {
-            for (size_t i = size(); i <= (size_t)index; i++)
+            if (*cur < '0' || *cur > '9')
+            {
+                return false;
+            }
+
+            uint64_t digit = (uint64_t)(*cur - '0');
+            if (integer > (std::numeric_limits<uint64_t>::max() - digit) / 10)
             {
-                add(std::make_shared<JsonW>());
+                return false;
             }
+            integer = integer * 10 + digit;
         }
 
-        return *(get(index));
-    }
-
-    JsonW& operator[] (const char* name)
-    {
-        // convert to wstring
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        std::wstring wname = conv.from_bytes(name);
-
-        if (wname.length() == 0)
+        if (integer > (uint64_t)std::numeric_limits<T>::max())
         {
-            return bad();
+            return false;
         }
 
-        if (type_ != OBJECT)
+        value = (T)integer;
+        return true;
+    }
+
+    static void put(JsonWriterW& writer, bool value)
+    {
+        if (value)
         {
-            clean();
-            type_ = OBJECT;
-            valid_ = true;
+            writer.write("true", 4);
         }
-
-        if (jobject_.find(wname) == jobject_.end())
+        else
         {
-            jobject_.insert(std::pair<std::wstring, std::shared_ptr<JsonW>>(wname, std::make_shared<JsonW>()));
+            writer.write("false", 5);
         }
-
-        return *(jobject_.find(wname)->second);
     }
 
-    JsonW& operator[] (const std::string& name)
+    template <typename T>
+    static void put(JsonWriterW& writer, const T& value)
     {
-        // convert to wstring
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        std::wstring wname = conv.from_bytes(name);
+        put(writer, value, std::is_arithmetic<T>());
+    }
 
-        if (wname.length() == 0)
+    template <typename T>
+    static void put(JsonWriterW& writer, const T& value, std::true_type)
+    {
+        if (std::is_integral<T>::value && std::is_unsigned<T>::value)
         {
-            return bad();
+            writer.integer((unsigned long long)value);
         }
-
-        if (type_ != OBJECT)
+        else if (std::is_integral<T>::value)
         {
-            clean();
-            type_ = OBJECT;
-            valid_ = true;
+            writer.integer((long long)value);
         }
-
-        if (jobject_.find(wname) == jobject_.end())
+        else
         {
-            jobject_.insert(std::pair<std::wstring, std::shared_ptr<JsonW>>(wname, std::make_shared<JsonW>()));
+            writer.frac((long double)value);
         }
-
-        return *(jobject_.find(wname)->second);
     }
 
-    JsonW& operator[] (const wchar_t* name)
+    template <typename CharT>
+    static void put(JsonWriterW& writer, const std::basic_string<CharT>& value, std::false_type)
     {
-        // convert to wstring
-        std::wstring wname(name);
+        writer.string(value.data(), value.length());
+    }
 
-        if (wname.length() == 0)
+    template <typename T>
+    static void put(JsonWriterW& writer, const std::vector<T>& value, std::false_type)
+    {
+        writer.put('[');
+        for (size_t i = 0; i < value.size(); i++)
         {
-            return bad();
+            if (i > 0)
+            {
+                writer.put(',');
+            }
+            put(writer, (const T&)value[i]);
         }
+        writer.put(']');
+    }
 
-        if (type_ != OBJECT)
-        {
-            clean();
-            type_ = OBJECT;
-            valid_ = true;
-        }
+    template <typename T>
+    static void put(JsonWriterW& writer, const T& value, std::false_type)
+    {
+        Writer visitor = { writer, true };
+        jsonw_fields(value, visitor);
 
-        if (jobject_.find(wname) == jobject_.end())
+        if (visitor.first)
         {
-            jobject_.insert(std::pair<std::wstring, std::shared_ptr<JsonW>>(wname, std::make_shared<JsonW>()));
+            writer.put('{');
         }
+        writer.put('}');
+    }
+};
+
+// BasicJsonPushParserW parses utf8 json that arrives in chunks, such as the
+// data read from a socket. Each feed() continues from where the previous
+// one stopped, so no chunk is scanned twice. A string, number or literal
+// cut by the chunk boundary, including \u escape and utf8 sequence, is kept
+// until the rest of it arrives. Containers are kept on an explicit stack,
+// nodes are built as soon as their text is complete. feed() returns
+// COMPLETE once the json value is complete. A number at top level can only
+// be completed by the next character or finish().
+template <typename CharT>
+class BasicJsonPushParserW
+{
+public:
+    const static int INCOMPLETE = 0;
+    const static int COMPLETE = 1;
+    const static int BAD = 2;
 
-        return *(jobject_.find(wname)->second);
+public:
+    explicit BasicJsonPushParserW(const JsonOptionsW& options = JsonOptionsW())
+        : options_(options)
+    {
     }
 
-    JsonW& operator[] (const std::wstring& wname)
+    // parse next chunk of utf8 json text, return INCOMPLETE, COMPLETE or
+    // BAD. Data after the complete value is not consumed, see consumed().
+    int feed(const char* utf8data, size_t length)
     {
-        if (wname.length() == 0)
-        {
-            return bad();
-        }
+        consumed_ = 0;
 
-        if (type_ != OBJECT)
+        if (status_ != INCOMPLETE)
         {
-            clean();
-            type_ = OBJECT;
-            valid_ = true;
+            return status_;
         }
 
-        if (jobject_.find(wname) == jobject_.end())
+        const char* cur = utf8data;
+        const char* end = utf8data + length;
+
+        if (token_ == NONE || resume(cur, end))
         {
-            jobject_.insert(std::pair<std::wstring, std::shared_ptr<JsonW>>(wname, std::make_shared<JsonW>()));
+            run(cur, end);
         }
 
-        return *(jobject_.find(wname)->second);
+        consumed_ = cur - utf8data;
+        return status_;
     }
 
-    // format json data into utf8 text in json standard
-    std::wstring wtext( bool singleline = true ) const
+    int feed(const std::string& utf8str)
     {
-        std::wstringstream wss;
-        wss_jvalue(wss, *this, singleline);
-        return wss.str();
+        return feed(utf8str.data(), utf8str.length());
     }
 
-    // format json data into ucs text
-    std::string text( bool singleline = true ) const
+    // no more data, complete the number at top level. Return COMPLETE if
+    // the json value is complete, otherwise BAD
+    int finish()
     {
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        return conv.to_bytes(wtext( singleline ));
-    }
+        if (status_ == INCOMPLETE)
+        {
+            if (token_ == NUMBER && stack_.empty())
+            {
+                token_ = NONE;
+                number(pending_.data(), pending_.data() + pending_.length());
+            }
 
-    friend std::ostream& operator<<(std::ostream& os, const JsonW& rhs)
-    {
-        os << rhs.text();
-        return os;
+            if (status_ == INCOMPLETE)
+            {
+                status_ = BAD;
+            }
+        }
+
+        return status_;
     }
 
-    friend std::wostream& operator<<(std::wostream& wos, const JsonW& rhs)
+    int status() const { return status_; }
+
+    // bytes of last feed() parsed into the value, the rest belongs to next
+    // json value
+    size_t consumed() const { return consumed_; }
+
+    // parsed json value, null until status is COMPLETE
+    std::shared_ptr<BasicJsonW<CharT>> root() const
     {
-        wos << rhs.wtext();
-        return wos;
+        return status_ == COMPLETE ? root_ : std::shared_ptr<BasicJsonW<CharT>>();
     }
 
-public:
-    // Singleton bad JsonW instance
-    static JsonW& bad()
+    // clear all state to parse next json value
+    void reset()
     {
-        static JsonW instance;
-        instance.type_ = BAD;
-        instance.valid_ = false;
-        return instance;
+        status_ = INCOMPLETE;
+        token_ = NONE;
+        escape_ = false;
+        pending_.clear();
+        stack_.clear();
+        root_.reset();
+        consumed_ = 0;
     }
 
 private:
-    // private static help function - parse token into json object 
-    static bool jobject(std::queue<JsonTokenW>& tokens, std::map<std::wstring, std::shared_ptr<JsonW>>& jobject)
+    typedef BasicJsonW<CharT> Json;
+    typedef typename Json::Key Key;
+
+    // scanning state of the token that is cut by the chunk boundary
+    const static int NONE = 0;
+    const static int STRING = 1;
+    const static int NUMBER = 2;
+    const static int LITERAL = 3;
+
+    // what the container expects next
+    const static int OBJECT_KEY = 0;    // key or '}'
+    const static int OBJECT_COLON = 1;  // ':'
+    const static int OBJECT_VALUE = 2;  // value
+    const static int OBJECT_NEXT = 3;   // ',', key or '}'
+    const static int ARRAY_VALUE = 4;   // value or ']'
+    const static int ARRAY_NEXT = 5;    // ',' or ']'
+
+    struct Frame
     {
-        // Object must start with LeftCurlyBracket:'{' and minimum size is 2 '{' + '}'
-        if (tokens.size() < 2 ||
-            tokens.front().type() != JsonTokenW::Type::LeftCurlyBracket)
-        {
-            return false;
-        }
-        tokens.pop();
+        std::shared_ptr<Json> node;
+        int state;
+        Key key;
+    };
 
-        while (!tokens.empty())
+    // parse [cur, end) until the value is complete, the data runs out or
+    // the text is invalid
+    void run(const char*& cur, const char* end)
+    {
+        while (status_ == INCOMPLETE && JsonTokenW::skip(cur, end))
         {
-            std::wstring key;
-            switch (tokens.front().type())
+            int state = stack_.empty() ? OBJECT_VALUE : stack_.back().state;
+
+            switch (state)
             {
-            case JsonTokenW::Type::RightCurlyBracket:
-                tokens.pop();
-                return true;
-            case JsonTokenW::Type::String:
-                key = tokens.front().wstring();
-                if (key.length() == 0)
+            case OBJECT_NEXT:
+                if (*cur == ',')
                 {
-                    return false;
+                    cur++;
+                    stack_.back().state = OBJECT_KEY;
+                    break;
                 }
-                else if (jobject.count(key) > 0)
+                // comma is optional between members
+                // fall through
+            case OBJECT_KEY:
+                if (*cur == '}')
                 {
-                    return false; // not allow duplicate key
+                    cur++;
+                    close();
                 }
-
-                tokens.pop();
-                if (tokens.empty())
+                else if (*cur == '\"')
                 {
-                    return false;
+                    token(cur, end, STRING);
                 }
-                else if (tokens.front().type() != JsonTokenW::Type::Colon)
+                else
                 {
-                    return false;
+                    status_ = BAD;
                 }
-
-                tokens.pop();
-                if (tokens.empty())
+                break;
+            case OBJECT_COLON:
+                if (*cur == ':')
                 {
-                    return false;
+                    cur++;
+                    stack_.back().state = OBJECT_VALUE;
                 }
                 else
                 {
-                    std::shared_ptr<JsonW> junit = std::make_shared<JsonW>(tokens);
-
-                    if (junit->valid() == false)
-                    {
-                        return false;
-                    }
-                    else
-                    {
-                        jobject[key] = junit;
-                    }
+                    status_ = BAD;
                 }
-
-                if (!tokens.empty() && tokens.front().type() == JsonTokenW::Type::Comma)
+                break;
+            case ARRAY_NEXT:
+                if (*cur == ',')
                 {
-                    // consume comma and expect next key-data set
-                    tokens.pop();
+                    cur++;
+                    stack_.back().state = ARRAY_VALUE;
                 }
-
-                break;
-            case JsonTokenW::Type::LeftCurlyBracket:
-            case JsonTokenW::Type::LeftSquareBracket:
-            case JsonTokenW::Type::RightSquareBracket:
-            case JsonTokenW::Type::NumberInteger:
-            case JsonTokenW::Type::NumberFloat:
-            case JsonTokenW::Type::Boolean:
-            case JsonTokenW::Type::Null:
-            case JsonTokenW::Type::Colon:
-            case JsonTokenW::Type::Comma:
-            case JsonTokenW::Type::Bad:
-            default:
-                return false;
-            }
-        }
-
-        return false;
-    }
-
-    // private static help function - parse tokens into json array
-    static bool jarray(std::queue<JsonTokenW>& tokens, std::vector<std::shared_ptr<JsonW>>& jarray)
-    {
-        // Object must start with LeftCurlyBracket:'[' and minimum size is 2 '[' + ']'
-        if (tokens.size() < 2 ||
-            tokens.front().type() != JsonTokenW::Type::LeftSquareBracket)
-        {
-            return false;
-        }
-        tokens.pop();
-
-        while (!tokens.empty())
-        {
-            switch (tokens.front().type())
-            {
-            case JsonTokenW::Type::RightSquareBracket:
-                tokens.pop();
-                return true;
-            case JsonTokenW::Type::LeftCurlyBracket:
-            case JsonTokenW::Type::LeftSquareBracket:
-            case JsonTokenW::Type::NumberInteger:
-            case JsonTokenW::Type::NumberFloat:
-            case JsonTokenW::Type::Boolean:
-            case JsonTokenW::Type::String:
-            case JsonTokenW::Type::Null:
-            {
-                std::shared_ptr<JsonW> junit = std::make_shared<JsonW>(tokens);
-                if (junit->valid() == false)
+                else if (*cur == ']')
                 {
-                    return false;
+                    cur++;
+                    close();
                 }
-
-                jarray.push_back(junit);
-
-                // if followed by comma, continually read next JsonUnitW
-                if (!tokens.empty() && tokens.front().type() == JsonTokenW::Type::Comma)
+                else
                 {
-                    tokens.pop();
-                    continue;
+                    status_ = BAD;
                 }
-                else if (!tokens.empty() && tokens.front().type() == JsonTokenW::Type::RightSquareBracket)
+                break;
+            case ARRAY_VALUE:
+                if (*cur == ']')
                 {
-                    tokens.pop();
-                    return true;
+                    cur++;
+                    close();
+                    break;
                 }
-                else
+                else if (*cur == '}' || *cur == ':' || *cur == ',')
                 {
-                    return false;
+                    status_ = BAD;
+                    break;
                 }
-            }
-
-            // invalid
-            case JsonTokenW::Type::RightCurlyBracket:
-            case JsonTokenW::Type::Colon:
-            case JsonTokenW::Type::Comma:
-            case JsonTokenW::Type::Bad:
+                // fall through
             default:
-                return false;
+                value(cur, end);
             }
         }
-
-        return false;
     }
-    
-    // private static help function, write value into string buffer in json format 
-    static std::wstringstream& wss_jvalue(std::wstringstream& wss, const JsonW& jvalue, bool singleline = true, size_t level = 0 )
+
+    // begin of a json value
+    void value(const char*& cur, const char* end)
     {
-        if (jvalue.valid() == false)
-        {
-            return wss;
-        }
+        std::shared_ptr<Json> node;
 
-        switch (jvalue.type())
-        {
-        case JsonW::INTEGER:
-            wss << std::to_wstring(jvalue.integer());
-            return wss;
-        case JsonW::FLOAT:
-            wss << std::to_wstring(jvalue.frac());
-            return wss;
-        case JsonW::BOOLEAN:
-            if (jvalue.boolean())
-            {
-                wss << L"true";
-                return wss;
-            }
-            else
-            {
-                wss << L"false";
-                return wss;
-            }
-        case JsonW::NULLVALUE:
-            wss << L"null";
-            return wss;
-        case JsonW::STRING:
-            return wss_string(wss, jvalue.wstr());
-        case JsonW::OBJECT:
-        {
-            if ( singleline )
-            {
-                return wss_jobject( wss, jvalue );
-            }
-            else
-            {
-                return wss_jobject( wss, jvalue, singleline, level );
-            }
-        }            
-        case JsonW::ARRAY:
+        switch (*cur)
         {
-            std::wstringstream wsstmp;
-            wss_jarray( wsstmp, jvalue);
-            std::wstring wstr = wsstmp.str();
-            
-            if ( singleline || wstr.length() <= 20 )
-            {
-                wss << wstr;
-                return wss;
-            }
-            else
-            {
-                return wss_jarray( wss, jvalue, singleline, level );
-            }                     
-        }
-        case JsonW::BAD:
+        case '{':
+            cur++;
+            node = Json::node(options_.arena);
+            node->clean(Json::OBJECT, options_.objects);
+            open(node, OBJECT_KEY);
+            return;
+        case '[':
+            cur++;
+            node = Json::node(options_.arena);
+            node->clean(Json::ARRAY);
+            open(node, ARRAY_VALUE);
+            return;
+        case '\"':
+            token(cur, end, STRING);
+            return;
+        case 't': case 'f': case 'n':
+            token(cur, end, LITERAL);
+            return;
+        case '-': case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            token(cur, end, NUMBER);
+            return;
         default:
-            return wss;
+            status_ = BAD;
         }
     }
-    
-    static std::wstringstream& wss_jobject(std::wstringstream& wss, const JsonW& jobject, 
-        bool singleline = true, size_t level = 0, bool addcomma = false )
+
+    // scan a string, number or literal starting at 'cur', keep it in
+    // pending_ if it is cut by the end of data
+    void token(const char*& cur, const char* end, int type)
     {
-        std::vector<std::wstring> wkeys;
-        jobject.wkeys(wkeys);
-        size_t level_plus = 0;
-        
-        if ( singleline == false )
-        {            
-            level_plus = level + 1;
-        }
+        const char* begin = cur;
 
-        wss_intent(wss, level) << L"{";
-        
-        if ( singleline == false )
+        token_ = type;
+        escape_ = false;
+        literal_ = type != LITERAL ? "" : (*cur == 't' ? "true" : (*cur == 'f' ? "false" : "null"));
+
+        if (!tokenend(cur, end, type == STRING ? cur + 1 : cur))
         {
-            wss << std::endl;
+            pending_.assign(begin, end);
+            return;
         }
 
-        for (size_t i = 0; i < wkeys.size(); i++)
+        token_ = NONE;
+        complete(type, begin, cur);
+    }
+
+    // continue the pending token with new data, return false if the token
+    // is still not complete or it is invalid
+    bool resume(const char*& cur, const char* end)
+    {
+        int type = token_;
+        const char* begin = cur;
+        bool done = tokenend(cur, end, cur);
+
+        pending_.append(begin, cur);
+        if (!done)
         {
-            bool newline = false;
-            bool comma_in_function = true;
-            
-            wss_intent(wss, level_plus);
-            wss_string(wss, wkeys.at(i)) << L":";
-            
-            // 'name : value'
-            // when we need to add std::endl after ':'
-            // 1. value is json object
-            // 2. value is json array and length + level*4 > 40
-            std::shared_ptr<JsonW> jvalue = jobject.get(wkeys.at(i));
-             
-            if ( singleline == false )
-            {
-                size_t estimate_size = 0;
-                std::wstringstream wsstmp;
-                wss_jvalue(wsstmp, *(jvalue.get()));
-                estimate_size = wsstmp.str().length();
+            return false;
+        }
 
-                if ( jvalue->type() == JsonW::OBJECT && jvalue->size() > 1 )
-                {
-                    if (jvalue->size() > 1 || estimate_size > 20)
-                    {
-                        newline = true;
-                        wss << std::endl;
-                    }
-                }
-                else if ( jvalue->type() == JsonW::ARRAY )
-                {
-                    bool has_object_array = false;
+        token_ = NONE;
+        complete(type, pending_.data(), pending_.data() + pending_.length());
+        pending_.clear();
 
-                    for (size_t j = 0; j < jvalue->size(); j++)
-                    {
-                        if (jvalue->get(j)->type() == JsonW::ARRAY ||
-                            jvalue->get(j)->type() == JsonW::OBJECT)
-                        {
-                            has_object_array = true;
-                        }
-                    }
+        return status_ == INCOMPLETE;
+    }
 
-                    if (has_object_array || wsstmp.str().length() > 20 )
-                    {
-                        newline = true;
-                        wss << std::endl;
-                    }
-                }             
-            }
-            
-            if ( newline == false )
+    // find the end of token from 'from', return false if the data runs out
+    // first. 'cur' is moved to the end of token.
+    bool tokenend(const char*& cur, const char* end, const char* from)
+    {
+        const char* pos = from;
+
+        switch (token_)
+        {
+        case STRING:
+            while (pos < end)
             {
-                if (i < wkeys.size() - 1)
+                if (escape_)
                 {
-                    wss_jvalue(wss, *(jvalue.get())) << L",";
+                    escape_ = false;
+                    pos++;
+                    continue;
                 }
-                else
+
+                // skip plain text in bulk
+                pos = JsonSimdW::findspecial(pos, end);
+                if (pos >= end)
                 {
-                    wss_jvalue(wss, *(jvalue.get()));
+                    break;
                 }
-            }
-            else
-            {
-                if (i < wkeys.size() - 1)
+
+                char character = *pos++;
+                if (character == '\\')
                 {
-                    if (jvalue->type() == JsonW::OBJECT)
-                    {
-                        comma_in_function = false;
-                        wss_jobject(wss, *(jvalue.get()), singleline, level_plus, true);
-                    }
-                    else if (jvalue->type() == JsonW::ARRAY)
-                    {
-                        comma_in_function = false;
-                        wss_jarray(wss, *(jvalue.get()), singleline, level_plus, true);
-                    }
-                    else
-                    {
-                        wss_jvalue(wss, *(jvalue.get()), singleline, level_plus) << L",";
-                    }
+                    escape_ = true;
                 }
-                else
+                else if (character == '\"' || character == '\r' || character == '\n')
                 {
-                    wss_jvalue(wss, *(jvalue.get()));
+                    // string is complete, or invalid at unexpected EOL
+                    cur = pos;
+                    return true;
                 }
             }
-            
-            if ( singleline == false && comma_in_function )
+            break;
+        case NUMBER:
+            while (pos < end && isnumberchar(*pos))
+            {
+                pos++;
+            }
+
+            if (pos < end)
+            {
+                cur = pos;
+                return true;
+            }
+            break;
+        case LITERAL:
+        {
+            // literal is complete once it has as many characters as expected
+            size_t need = std::strlen(literal_) - pending_.length();
+            if ((size_t)(end - cur) >= need)
             {
-                wss << std::endl;
+                cur += need;
+                return true;
             }
+            break;
         }
+        }
+
+        cur = end;
+        return false;
+    }
 
-        if ( singleline )
+    // the whole text of token is [begin, last)
+    void complete(int type, const char* begin, const char* last)
+    {
+        switch (type)
         {
-            wss << L"}";
+        case STRING:
+            string(begin, last);
+            break;
+        case NUMBER:
+            number(begin, last);
+            break;
+        case LITERAL:
+            literal(begin, last);
+            break;
         }
-        else if ( addcomma )
+    }
+
+    void string(const char* begin, const char* last)
+    {
+        // string is a key if the object expects one
+        if (!stack_.empty() && (stack_.back().state == OBJECT_KEY || stack_.back().state == OBJECT_NEXT))
         {
-            wss_intent(wss, level) << L"}," << std::endl;
+            buffer_.clear();
+            if (!JsonTokenW::scanstring(begin, last, buffer_) || begin != last || buffer_.length() == 0)
+            {
+                status_ = BAD;
+                return;
+            }
+
+            Frame& frame = stack_.back();
+            frame.key = options_.keys ? options_.keys->intern(buffer_) : Key(buffer_);
+            frame.state = OBJECT_COLON;
+            return;
         }
-        else
+
+        std::shared_ptr<Json> node = Json::node(options_.arena);
+        node->clean(Json::STRING);
+
+        if (!JsonTokenW::scanstring(begin, last, *node->string_) || begin != last)
         {
-            wss_intent(wss, level) << L"}" << std::endl;
+            status_ = BAD;
+            return;
         }
-                
-        return wss;
+
+        node->valid_ = true;
+        add(node);
     }
-    
-    static std::wstringstream& wss_jarray(std::wstringstream& wss, const JsonW& jarray, 
-        bool singleline = true, size_t level = 0, bool addcomma = false )
+
+    void number(const char* begin, const char* last)
     {
-        size_t size = jarray.size();
-        size_t level_plus = 0;
-        
-        if ( singleline == false )
+        int_fast64_t integer;
+        long double frac;
+        std::shared_ptr<Json> node = Json::node(options_.arena);
+
+        switch (JsonTokenW::scannumber(begin, last, integer, frac))
         {
-            level_plus = level + 1;
+        case JsonTokenW::Type::NumberInteger:
+            node->type_ = Json::INTEGER;
+            node->integer_ = integer;
+            break;
+        case JsonTokenW::Type::NumberFloat:
+            node->type_ = Json::FLOAT;
+            node->frac_ = frac;
+            break;
+        default:
+            status_ = BAD;
+            return;
         }
-        
-        wss_intent(wss, level) << L"[";
-        
-        if ( singleline == false )
+
+        // the rest of number text cannot follow a value
+        if (begin != last)
         {
-            wss << std::endl;
+            status_ = BAD;
+            return;
         }
-        
-        for (size_t i = 0; i < size; i++)
+
+        node->valid_ = true;
+        add(node);
+    }
+
+    void literal(const char* begin, const char* last)
+    {
+        if (!JsonTokenW::scanliteral(begin, last, literal_))
         {
-            std::shared_ptr<JsonW> jvalue = jarray.get(i);
-            bool newline_end = true;
+            status_ = BAD;
+            return;
+        }
 
-            if (singleline == false)
-            {
-                size_t estimate_size = 0;
-                std::wstringstream wsstmp;
-                wss_jvalue(wsstmp, *(jvalue.get()));
-                estimate_size = wsstmp.str().length();
+        std::shared_ptr<Json> node = Json::node(options_.arena);
+        if (literal_[0] != 'n')
+        {
+            node->type_ = Json::BOOLEAN;
+            node->boolean_ = literal_[0] == 't';
+        }
+        node->valid_ = true;
+        add(node);
+    }
 
-                if (jvalue->type() == JsonW::OBJECT && 
-                    ( jvalue->size() > 1 || estimate_size > 20))
-                {
-                    newline_end = false;
-                    if (i < size - 1)
-                    {
-                        wss_jobject(wss, *(jvalue.get()), singleline, level_plus, true);
-                    }
-                    else
-                    {
-                        wss_jobject(wss, *(jvalue.get()), singleline, level_plus);
-                    }
-                }
-                else if (jvalue->type() == JsonW::ARRAY && estimate_size > 20 )
-                {
-                    newline_end = false;
-                    if (i < size - 1)
-                    {  
-                        wss_jarray(wss, *(jvalue.get()), singleline, level_plus, true);
-                    }
-                    else
-                    {
-                        wss_jarray(wss, *(jvalue.get()), singleline, level_plus);
-                    }
-                }
-                else
-                {
-                    wss_intent(wss, level_plus);
-                    wss_jvalue(wss, *(jvalue.get()));
+    void open(const std::shared_ptr<Json>& node, int state)
+    {
+        Frame frame;
+        frame.node = node;
+        frame.state = state;
+        stack_.push_back(std::move(frame));
+    }
 
-                    if (i < size - 1)
-                    {
-                        wss << L",";
-                    }
-                }
-            }
-            else
-            {
-                wss_jvalue(wss, *(jvalue.get()), singleline, level_plus);
+    // end of the innermost container
+    void close()
+    {
+        std::shared_ptr<Json> node = std::move(stack_.back().node);
+        stack_.pop_back();
 
-                if (i < size - 1)
-                {
-                    wss << L",";
-                }
-            }
-            
-            if ( singleline == false && newline_end)
-            {
-                wss << std::endl;
-            }
+        // not allow duplicate key
+        if (node->type() == Json::OBJECT && !node->jobject_->finish())
+        {
+            status_ = BAD;
+            return;
         }
-        
-        if ( singleline )
+
+        node->valid_ = true;
+        add(node);
+    }
+
+    // add complete value into its container
+    void add(const std::shared_ptr<Json>& node)
+    {
+        if (stack_.empty())
         {
-            wss <<  L"]";
+            root_ = node;
+            status_ = COMPLETE;
+            return;
         }
-        else if ( addcomma )
+
+        Frame& frame = stack_.back();
+        if (frame.state == OBJECT_VALUE)
         {
-            wss_intent(wss, level) << L"]," << std::endl;
+            frame.node->jobject_->append(std::make_pair(std::move(frame.key), node));
+            frame.state = OBJECT_NEXT;
         }
         else
         {
-            wss_intent(wss, level) << L"]" << std::endl;
+            frame.node->jarray_->push_back(node);
+            frame.state = ARRAY_NEXT;
         }
-        
-        return wss;
     }
-    
-    static std::wstringstream& wss_intent( std::wstringstream& wss, size_t level )
+
+    // characters that scannumber() may read
+    static bool isnumberchar(char character)
+    {
+        return (character >= '0' && character <= '9') || character == '-' ||
+            character == '+' || character == '.' || character == 'e' || character == 'E';
+    }
+
+private:
+    JsonOptionsW options_;
+    int status_ = INCOMPLETE;
+    size_t consumed_ = 0;
+
+    // token cut by the chunk boundary
+    int token_ = NONE;
+    bool escape_ = false;
+    const char* literal_ = "";
+    std::string pending_;
+
+    std::vector<Frame> stack_;
+    std::shared_ptr<Json> root_;
+    std::basic_string<CharT> buffer_;
+};
+
+typedef BasicJsonPushParserW<wchar_t> JsonPushParserW;
+typedef BasicJsonPushParserW<char> JsonPushParserU8;
+
+// BasicJsonLinesW parses newline delimited json (NDJSON, JSON Lines), each
+// line is an independent json value. The text is split into batches of
+// lines which are parsed by 'threads' worker threads, the caller thread
+// receives the parsed values in input order. Empty line is skipped, line
+// with invalid json gives an invalid value. Nodes are not allocated from
+// arena of JsonOptionsW, each worker interns keys in its own pool if the
+// options has one. Define OCTILLION_JSONW_DISABLE_THREAD to parse in the
+// caller thread only.
+template <typename CharT>
+class BasicJsonLinesW
+{
+public:
+    typedef BasicJsonW<CharT> Json;
+
+    // bytes of text in one batch, a batch ends at the end of line
+    const static size_t BATCH_SIZE = 64 * 1024;
+
+public:
+    // parse utf8 lines, return the values in input order. 'threads' is 0
+    // to use one thread per cpu core.
+    static std::vector<std::shared_ptr<Json>> parse(const char* utf8data, size_t length,
+        size_t threads = 0, const JsonOptionsW& options = JsonOptionsW())
     {
-        if ( level == 0 )
+        std::vector<std::shared_ptr<Json>> jsons;
+
+        foreach(utf8data, length, [&jsons](size_t, const std::shared_ptr<Json>& json)
         {
-            return wss;
-        }
-        
-        std::wstring intent(level * 4, L' ');
-        wss << intent;
-        return wss;
+            jsons.push_back(json);
+            return true;
+        }, threads, options);
+
+        return jsons;
+    }
+
+    static std::vector<std::shared_ptr<Json>> parse(const std::string& utf8str,
+        size_t threads = 0, const JsonOptionsW& options = JsonOptionsW())
+    {
+        return parse(utf8str.data(), utf8str.length(), threads, options);
     }
 
-    // private static help function, write string into string buffer in json format 
-    static std::wstringstream& wss_string(std::wstringstream& wss, const std::wstring& wstr)
+    // parse utf8 json lines file in place from a memory mapping
+    static std::vector<std::shared_ptr<Json>> load(const std::string& path,
+        size_t threads = 0, const JsonOptionsW& options = JsonOptionsW())
     {
-        wss << L"\"";
+        JsonFileW file(path);
+        return parse(file.data(), file.size(), threads, options);
+    }
+
+    // call 'callback(line, json)' in the caller thread for each value in
+    // input order, 'line' is the zero based line number. Callback returns
+    // false to stop, then foreach() returns false.
+    template <typename Callback>
+    static bool foreach(const char* utf8data, size_t length, Callback callback,
+        size_t threads = 0, const JsonOptionsW& options = JsonOptionsW())
+    {
+#if !defined(OCTILLION_JSONW_DISABLE_THREAD)
+        if (threads == 0)
+        {
+            threads = std::max(1U, std::thread::hardware_concurrency());
+        }
 
-        for (size_t i = 0; i < wstr.length(); i++)
+        if (threads > 1 && length > BATCH_SIZE)
         {
-            wchar_t wchar = wstr.at(i);
+            return parallel(utf8data, utf8data + length, callback, threads, options);
+        }
+#else
+        (void)threads;
+#endif
+        // each line is handed to callback before the next one is parsed
+        size_t lines = 0;
+        return scan(utf8data, utf8data + length, lines, options, callback);
+    }
+
+    template <typename Callback>
+    static bool foreachfile(const std::string& path, Callback callback,
+        size_t threads = 0, const JsonOptionsW& options = JsonOptionsW())
+    {
+        JsonFileW file(path);
+        return file.good() && foreach(file.data(), file.size(), callback, threads, options);
+    }
+
+private:
+    // parse the lines of [begin, end) one at a time and call 'visit(line,
+    // json)' for each value, 'lines' counts the lines scanned. Return false
+    // as soon as visit returns false.
+    template <typename Visit>
+    static bool scan(const char* begin, const char* end, size_t& lines,
+        const JsonOptionsW& options, Visit& visit)
+    {
+        const char* cur = begin;
 
-            switch (wchar)
+        while (cur < end)
+        {
+            const char* eol = static_cast<const char*>(std::memchr(cur, '\n', end - cur));
+            const char* next = eol == nullptr ? end : eol + 1;
+            const char* last = eol == nullptr ? end : eol;
+
+            // empty line is skipped
+            const char* text = cur;
+            if (JsonTokenW::skip(text, last) &&
+                !visit(lines, std::make_shared<Json>(text, last - text, options)))
             {
-            case 0x22: wss << L"\\\""; break;
-            case 0x5C: wss << L"\\\\"; break;
-            case 0x2F: wss << L"\\/"; break;
-            case 0x08: wss << L"\\b"; break;
-            case 0x0C: wss << L"\\f"; break;
-            case 0x0A: wss << L"\\n"; break;
-            case 0x0D: wss << L"\\r"; break;
-            case 0x09: wss << L"\\t"; break;
-            default: wss << wchar;
+                return false;
             }
+
+            lines++;
+            cur = next;
         }
 
-        wss << L"\"";
-        
-        return wss;
+        return true;
     }
 
-private:
-    // private help function, release all resource 
-    void clean()
+#if !defined(OCTILLION_JSONW_DISABLE_THREAD)
+    // lines [begin, end) and their values
+    struct Batch
     {
-        jobject_.clear();
-        jarray_.clear();
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        bool done = false;
+        size_t lines = 0;
+        std::vector<std::pair<size_t, std::shared_ptr<Json>>> jsons;
+    };
 
-        type_ = NULLVALUE;
-        valid_ = true;
+    // parse all lines of batch, line number is relative to the batch
+    static void parse(Batch& batch, const JsonOptionsW& options)
+    {
+        auto keep = [&batch](size_t line, const std::shared_ptr<Json>& json)
+        {
+            batch.jsons.push_back(std::make_pair(line, json));
+            return true;
+        };
+
+        scan(batch.begin, batch.end, batch.lines, options, keep);
     }
 
-    // private help function, read json data from wistream   
-    void init(std::wistream& ins)
+    template <typename Callback>
+    static bool deliver(Batch& batch, size_t line, Callback& callback)
     {
-        // set locale to utf8
-        std::queue<JsonTokenW> tokens;
-        ins.imbue(std::locale(ins.getloc(), new std::codecvt_utf8<wchar_t>));
+        for (auto& it : batch.jsons)
+        {
+            if (!callback(line + it.first, it.second))
+            {
+                return false;
+            }
+        }
 
-        // parse tokens
-        JsonTokenW::parse(ins, tokens);
+        return true;
+    }
 
-        // convert to junit
-        parse(tokens);
+    // state shared by workers and caller thread, guarded by mutex
+    struct Schedule
+    {
+        std::mutex mutex;
+        std::condition_variable done;   // a batch is parsed
+        std::condition_variable space;  // a batch is delivered
+        const char* cur;
+        const char* end;
+        size_t window;
+        bool stop = false;
+        std::deque<Batch> batches;      // in input order
+    };
+
+    template <typename Callback>
+    static bool parallel(const char* begin, const char* end, Callback& callback,
+        size_t threads, const JsonOptionsW& options)
+    {
+        Schedule schedule;
+        schedule.cur = begin;
+        schedule.end = end;
+        schedule.window = 4 * threads;
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < threads; i++)
+        {
+            workers.push_back(std::thread(work, std::ref(schedule), options));
+        }
+
+        bool success = true;
+        size_t line = 0;
+
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(schedule.mutex);
+            schedule.done.wait(lock, [&schedule]()
+            {
+                return schedule.batches.empty() ? schedule.cur >= schedule.end : schedule.batches.front().done;
+            });
+
+            if (schedule.batches.empty())
+            {
+                break;
+            }
+
+            Batch batch = std::move(schedule.batches.front());
+            schedule.batches.pop_front();
+            schedule.space.notify_all();
+            lock.unlock();
+
+            if (!deliver(batch, line, callback))
+            {
+                success = false;
+                break;
+            }
+            line += batch.lines;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(schedule.mutex);
+            schedule.stop = true;
+            schedule.space.notify_all();
+        }
+
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        return success;
     }
 
-private:
-    // private member data
-    int type_ = NULLVALUE;
-    bool valid_ = false;
+    // worker thread, take next batch of lines and parse it
+    static void work(Schedule& schedule, JsonOptionsW options)
+    {
+        options.threads = 1;
+        options.arena.reset();
+        if (options.keys)
+        {
+            options.keys = std::make_shared<JsonKeyPoolW>();
+        }
 
-    long long integer_ = 0;
-    long double frac_ = 0.0;
-    std::wstring wstring_;
-    bool boolean_ = true;
-    
-    std::map<std::wstring, std::shared_ptr<JsonW>> jobject_;
-    std::vector<std::shared_ptr<JsonW>> jarray_;
+        std::unique_lock<std::mutex> lock(schedule.mutex);
+
+        while (true)
+        {
+            schedule.space.wait(lock, [&schedule]()
+            {
+                return schedule.stop || schedule.cur >= schedule.end ||
+                    schedule.batches.size() < schedule.window;
+            });
+
+            if (schedule.stop || schedule.cur >= schedule.end)
+            {
+                return;
+            }
+
+            // the batch ends at the end of line after BATCH_SIZE bytes
+            const char* begin = schedule.cur;
+            const char* limit = (size_t)(schedule.end - begin) > BATCH_SIZE ? begin + BATCH_SIZE : schedule.end;
+            const char* eol = static_cast<const char*>(std::memchr(limit, '\n', schedule.end - limit));
+
+            schedule.cur = eol == nullptr ? schedule.end : eol + 1;
+            schedule.batches.push_back(Batch());
+
+            // reference to element of deque is kept by push_back/pop_front
+            Batch& batch = schedule.batches.back();
+            batch.begin = begin;
+            batch.end = schedule.cur;
 
+            lock.unlock();
+            parse(batch, options);
+            lock.lock();
+
+            batch.done = true;
+            schedule.done.notify_all();
+        }
+    }
+#endif
 };
 
+typedef BasicJsonLinesW<wchar_t> JsonLinesW;
+typedef BasicJsonLinesW<char> JsonLinesU8;
+
 #endif // OCTILLION_JSONW_HEADER
\ No newline at end of file
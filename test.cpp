@@ -1,10 +1,52 @@
 
 #include <iostream>
+#include <cstdio>    // snprintf
+#include <cstdlib>   // strtod
+#include <cstring>   // memcpy
+#include <random>    // number samples
+#include <new>       // bad_alloc
+#include <chrono>    // number benchmark
 
 #include "jsonw.hpp"
 
 using namespace octillion;
 
+// count and bytes of global operator new calls, see
+// how_to_move_without_copy()
+static size_t allocations = 0;
+static size_t allocated = 0;
+
+// operator delete is kept out of line, gcc takes free() of the pointer of
+// operator new for a mismatch once it is inlined into delete expression
+#if defined(__GNUC__)
+#define TEST_NOINLINE __attribute__((noinline))
+#else
+#define TEST_NOINLINE
+#endif
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    allocated += size;
+
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+TEST_NOINLINE void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+TEST_NOINLINE void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
 // show how to read json from buffer contains utf8 data
 void read_json_from_utf8_data();
 
@@ -14,6 +56,15 @@ void read_json_from_usc_data();
 // show how to read json from utf8 file
 void read_json_from_utf8_file();
 
+// show how to keep utf8 text as it is with JsonU8
+void read_json_into_utf8_storage();
+
+// show that the text written by JsonW is read again as the same json
+void read_own_text_again();
+
+// show that malformed value found by lazy parse is not written as text
+void read_malformed_lazy_json();
+
 // show how to create json as below programatically
 // {
 //     "txt1": "some text1",
@@ -35,22 +86,71 @@ void how_to_work_with_value();
 // show how to work with object
 void how_to_work_with_object();
 
+// show how to build and erase a large object in code
+void how_to_build_large_object();
+
 // show how to work with array
 void how_to_work_with_array();
 
 // memory management - avoiding deep copy to save memory
 void how_to_avoid_deep_copy();
 
+// memory management - move values without allocation
+void how_to_move_without_copy();
+
+// memory management - parse request scoped json into an arena
+void how_to_use_arena_document();
+
+// memory management - memory used by the values of sample.json
+void how_much_memory_json_uses();
+
+// number - floating point number is read as strtod reads it
+void check_numbers_against_strtod();
+
+// number - time to read a number heavy array, compared with strtod
+void how_fast_numbers_are_read();
+
+// struct binding - unsigned 64 bit member keeps its full range
+struct Counter
+{
+    uint64_t count = 0;
+    std::vector<uint64_t> samples;
+};
+OCTILLION_JSONW_BIND(Counter, count, samples)
+
+void bind_unsigned_64_bit_number();
+
+// struct binding - text that JsonW does not read is not bound either
+struct Reading
+{
+    float level = 0;
+    int8_t small = 0;
+};
+OCTILLION_JSONW_BIND(Reading, level, small)
+
+void bind_rejected_members();
+
 int main()
 {
     read_json_from_utf8_data();
     read_json_from_usc_data();
     read_json_from_utf8_file();
+    read_json_into_utf8_storage();
+    read_own_text_again();
+    read_malformed_lazy_json();
     create_json_programatically();
     how_to_work_with_value();
     how_to_work_with_object();
+    how_to_build_large_object();
     how_to_work_with_array();
     how_to_avoid_deep_copy();
+    how_to_move_without_copy();
+    how_to_use_arena_document();
+    how_much_memory_json_uses();
+    check_numbers_against_strtod();
+    how_fast_numbers_are_read();
+    bind_unsigned_64_bit_number();
+    bind_rejected_members();
 
     // see README.md for the memory leak detection
 #ifdef  OCTILLION_JSONW_ENABLE_MEMORY_LEAK_DETECTION
@@ -105,6 +205,53 @@ void read_json_from_utf8_file()
     std::cout << json  << std::endl;
 }
 
+void read_json_into_utf8_storage()
+{
+    // string and key are stored in utf8
+    JsonU8 json(u8"{\"name\":\"meowyih\",\"age\":123}");
+
+    // no conversion since the value is stored in utf8
+    std::string name = json[u8"name"].str();
+
+    std::cout << name << std::endl;
+    std::cout << json << std::endl;
+}
+
+void read_own_text_again()
+{
+    // escaped character outside BMP and lone surrogates
+    JsonW json("[\"A\\ud83d\\ude00\", \"\\ud83d\", \"\\ude00B\"]");
+
+    std::string text = json.text();
+    JsonW again(text.c_str());
+
+    bool same = again.valid() && again.size() == 3;
+    for (size_t i = 0; same && i < 3; i++)
+    {
+        same = again[i].wstr() == json[i].wstr();
+    }
+
+    std::cout << text << " read again " << (same ? "ok" : "FAILED") << std::endl;
+}
+
+void read_malformed_lazy_json()
+{
+    JsonOptionsW options;
+    options.lazy = true;
+
+    // nested array and object are only checked when they are reached
+    std::string text = u8"{\"a\":[1 2],\"b\":1,\"c\":{\"x\":1,\"x\":2}}";
+    JsonW lazy(text.data(), text.size(), options);
+    bool deferred = lazy.valid();
+
+    // the malformed values have no text, so neither has the json
+    bool empty = lazy.text().empty() && lazy.text(false).empty() &&
+        lazy.wtext().empty() && lazy.serialized_size() == 0 &&
+        lazy.to_msgpack().empty() && lazy.to_cbor().empty();
+
+    std::cout << "malformed lazy json " << ((deferred && empty && !lazy[u8"a"].valid()) ? "ok" : "FAILED") << std::endl;
+}
+
 // show how to create json as below programatically
 // {
 //     "txt1": "some text1",
@@ -262,6 +409,57 @@ void how_to_work_with_object()
     std::cout << jobject << std::endl;
 }
 
+void how_to_build_large_object()
+{
+    const int count = 100000;
+    char key[16];
+
+    JsonOptionsW options;
+    options.objects = JsonOptionsW::ORDERED;
+
+    JsonW jsorted("{}");
+    JsonW jordered("{}", 2, options);
+
+    // add keys in reverse key order, then erase the even ones
+    for (int i = count - 1; i >= 0; i--)
+    {
+        std::snprintf(key, sizeof(key), "k%06d", i);
+        jsorted.add(key, i);
+        jordered.add(key, i);
+    }
+
+    for (int i = 0; i < count; i += 2)
+    {
+        std::snprintf(key, sizeof(key), "k%06d", i);
+        jsorted.erase(key);
+        jordered.erase(key);
+    }
+
+    // an erased key can be added again
+    jsorted.add("k000000", 0);
+    jordered.add("k000000", 0);
+
+    bool same = jsorted.size() == count / 2 + 1 && jordered.size() == count / 2 + 1;
+    for (int i = 1; same && i < count; i += 2)
+    {
+        std::snprintf(key, sizeof(key), "k%06d", i);
+        same = jsorted.get(key) != nullptr && jsorted.get(key)->integer() == i &&
+            jordered.get(key) != nullptr && jordered.get(key)->integer() == i &&
+            jsorted.get(key + std::string("x")) == nullptr;
+    }
+
+    // sorted object lists keys in key order, ordered object in add order
+    std::vector<std::string> sorted, ordered;
+    jsorted.keys(sorted);
+    jordered.keys(ordered);
+
+    same = same && sorted.size() == count / 2 + 1 && ordered.size() == count / 2 + 1 &&
+        sorted.front() == "k000000" && sorted[1] == "k000001" && sorted.back() == "k099999" &&
+        ordered.front() == "k099999" && ordered[1] == "k099997" && ordered.back() == "k000000";
+
+    std::cout << "large object built and erased " << (same ? "ok" : "FAILED") << std::endl;
+}
+
 void how_to_work_with_array()
 {
     // create a test json text using ascii (utf8) string
@@ -289,20 +487,66 @@ void how_to_avoid_deep_copy()
     jarray[1] = 10; // JsonW automatically assign NULL to jarray[0]
     jobject["data"] = "data"; 
 
-    // deep copy jarray into jobject
+    // copy jarray into jobject, the array is shared until one changes
     jobject["array"] = jarray;
 
-    // deep copy jobject (as well as jarray) into json
+    // copy jobject (as well as jarray) into json, nothing is cloned
     json["object"] = jobject;
 
     std::cout << "json:" << json << std::endl;
 
-    // it is not a problem when data size is small, however,
-    // if JsonW contains huge data, says 100MB. Deep copy might
-    // be a problem if the memory usage is a concern.
+    // changing the copy clones only the changed level
+    json["object"]["data"] = "changed";
+    std::cout << "jobject:" << jobject << std::endl;
+
+    // a value changed in place via get() is never seen by copies
+    JsonW original("{\"x\":1,\"y\":[2]}");
+    JsonW copied(original);
+    copied.get("x")->integer(99);
+    copied.get("y")->get(0)->integer(99);
+
+    // a value kept from get() before copying is not shared either
+    std::shared_ptr<JsonW> x = original.get("x");
+    JsonW later(original);
+    x->integer(42);
+
+    std::cout << "original:" << original << " copied:" << copied << " later:" << later << std::endl;
+    std::cout << "copy changed via get() " << ((original.get("x")->integer() == 42 && original.get("y")->get(0)->integer() == 2 && later.get("x")->integer() == 1) ? "ok" : "FAILED") << std::endl;
+
+    // a reference taken before copying is not shared with the copy
+    JsonW root;
+    JsonW& a = root[u8"a"];
+    JsonW& b = root[u8"b"].emplace_back();
+    JsonW snap(root);
+    a[u8"x"] = 99;
+    b = 1;
+    std::cout << "copy before write through reference " << ((root.text() == "{\"a\":{\"x\":99},\"b\":[1]}" && snap.text() == "{\"a\":null,\"b\":[null]}") ? "ok" : "FAILED") << std::endl;
+
+    // reading a template through a const reference, or by get() once the
+    // values read are released, does not make its copies clone it
+    JsonW records;
+    for (int i = 0; i < 1000; i++)
+    {
+        records[u8"records"][i][u8"id"] = i;
+    }
+    records = JsonW(records.text().c_str());
+    const JsonW& view = records;
+    long long sum = view.get("records")->get(10)->get("id")->integer() + records.get("records")->get(20)->get("id")->integer();
+
+    size_t before = allocations;
+    JsonW record_copy(records);
+    size_t copied_after_read = allocations - before;
+
+    std::cout << "copy after read " << ((sum == 30 && copied_after_read == 0) ? "ok" : "FAILED") << std::endl;
 
-    // If caller has such concern, do not use assignment 
-    // operaotr (i.e. '='). Use size(JsonW::OBJECT)/get()/add()/keys() for json object
+    // a copy keeps the full long double value
+    JsonW precise;
+    precise.add("frac", 0.1L);
+    JsonW precise_copy(precise);
+    std::cout << "long double copied " << (precise_copy["frac"].frac() == 0.1L ? "ok" : "FAILED") << std::endl;
+
+    // values can also be put together without copy by
+    // size(JsonW::OBJECT)/get()/add()/keys() for json object
     // and size(JsonW::ARRAY)/get()/add() for json array
     JsonW *p_json, *p_object, *p_jarray;
 
@@ -334,4 +578,310 @@ void how_to_avoid_deep_copy()
     // when delete the p_json, all the JsonW objects in it
     // would be deleted, includes p_jobject and p_jarray.
     delete p_json;
+}
+
+// memory management - move values without allocation
+void how_to_move_without_copy()
+{
+    JsonW tree(u8"{\"name\":\"a string too long to be kept in place\",\"list\":[1,2,[3,4]]}");
+
+    // move construction and move assignment take the storage as it is
+    size_t before = allocations;
+    JsonW moved(std::move(tree));
+    size_t construct = allocations - before;
+
+    JsonW target;
+    before = allocations;
+    target = std::move(moved);
+    size_t assign = allocations - before;
+
+    // add() allocates the node that holds the child, the subtree is not
+    // copied, so adding it costs as much as adding a null value
+    JsonW small, large;
+    small.add(1);
+    large.add(1);
+
+    before = allocated;
+    small.add(JsonW());
+    size_t addnull = allocated - before;
+
+    before = allocated;
+    large.add(std::move(target));
+    size_t addtree = allocated - before;
+
+    std::cout << "allocations of move construct:" << construct
+        << " move assign:" << assign
+        << " bytes of add subtree beyond null:" << addtree - addnull << std::endl;
+    std::cout << "large:" << large << std::endl;
+
+    // a child can be moved into its own parent
+    JsonW parent(u8"[1,[2,\"a string too long to be kept in place\"]]");
+    parent = std::move(parent[1]);
+
+    JsonW owner(u8"{\"child\":{\"x\":[1,2]}}");
+    owner = std::move(owner["child"]);
+
+    std::cout << "move child into parent " << ((parent.text() == "[2,\"a string too long to be kept in place\"]" &&
+        owner.text() == "{\"x\":[1,2]}") ? "ok" : "FAILED") << std::endl;
+}
+
+// memory management - parse request scoped json into an arena
+void how_to_use_arena_document()
+{
+    // all values of the document are allocated from the arena of 'doc'
+    JsonDocumentW doc;
+
+    for (int i = 0; i < 3; i++)
+    {
+        std::string request = "{\"id\":" + std::to_string(i) + ",\"tags\":[\"a\",\"b\"]}";
+
+        // parse() releases the previous document and reuses the arena
+        if (!doc.parse(request))
+        {
+            continue;
+        }
+
+        std::cout << "request:" << doc.root()->text() << std::endl;
+    }
+
+    std::cout << "arena used:" << doc.arena().used() << " bytes" << std::endl;
+}
+
+// memory management - memory used by the values of sample.json
+void how_much_memory_json_uses()
+{
+    std::ifstream fin("sample.json");
+
+    if (!fin.good())
+    {
+        std::wcout << L"bad ifstream" << std::endl;
+        return;
+    }
+
+    std::string text(
+        (std::istreambuf_iterator<char>(fin)),
+        (std::istreambuf_iterator<char>()));
+
+    // each value in arena is one allocation, the node and its reference counter
+    JsonDocumentW doc;
+    doc.parse(text);
+
+    std::cout << "sizeof(JsonW):" << sizeof(JsonW) << " bytes" << std::endl;
+    std::cout << "sample.json values:" << doc.arena().live()
+        << " arena used:" << doc.arena().used() << " bytes" << std::endl;
+}
+
+// compare the number read by JsonU8 and JsonW with strtod, return false
+// if any of them differs
+static bool same_as_strtod(const char* text)
+{
+    double expected = std::strtod(text, nullptr);
+
+    // out of range number is not compared
+    if (std::isinf(expected))
+    {
+        return true;
+    }
+
+    std::string wrapped = std::string("[") + text + "]";
+    JsonU8 json(wrapped.c_str());
+    JsonW wjson(std::wstring(wrapped.begin(), wrapped.end()).c_str());
+
+    if (!json.valid() || !wjson.valid() ||
+        json[0].type() != JsonU8::FLOAT || wjson[0].type() != JsonW::FLOAT)
+    {
+        std::cout << "number " << text << " is not read as float" << std::endl;
+        return false;
+    }
+
+    double actual = (double)json[0].frac();
+    double wactual = (double)wjson[0].frac();
+
+    if (std::memcmp(&actual, &expected, sizeof(double)) != 0 ||
+        std::memcmp(&wactual, &expected, sizeof(double)) != 0)
+    {
+        std::cout << "number " << text << " differs from strtod" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// number - floating point number is read as strtod reads it
+void check_numbers_against_strtod()
+{
+    // uppercase exponent, exact power of ten, halfway between two doubles
+    // (ties to even), smallest normal and subnormal numbers
+    const char* samples[] =
+    {
+        "1E5", "-2E-3", "2.5E1", "1E+2", "1e23", "8.5e22", "1e22", "0.1",
+        "9007199254740993.0", "9007199254740995.0", "9007199254740993.00000000000001",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203126",
+        "2.2250738585072011e-308", "2.2250738585072014e-308",
+        "4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+        "1.7976931348623157e308", "123456789012345678901234567890e-10",
+        "0.000000000000000000000000000000000000000000001e300"
+    };
+
+    size_t checked = 0, failed = 0;
+
+    for (const char* sample : samples)
+    {
+        checked++;
+        failed += same_as_strtod(sample) ? 0 : 1;
+    }
+
+    std::mt19937_64 random(20231016);
+    char text[128];
+
+    for (int i = 0; i < 100000; i++)
+    {
+        // random double in shortest and shorter precision
+        uint64_t bits = random() & 0x7FEFFFFFFFFFFFFFULL;
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        std::snprintf(text, sizeof(text), "%.*e", (int)(random() % 17), value);
+        checked++;
+        failed += same_as_strtod(text) ? 0 : 1;
+
+        // near halfway between the double and the next one
+        long double half = ((long double)value + (long double)std::nextafter(value, 1e308)) / 2;
+        std::snprintf(text, sizeof(text), "%.25LE", half);
+        checked++;
+        failed += same_as_strtod(text) ? 0 : 1;
+
+        // random 1 to 25 digits with exponent in [-340, 320]
+        int digits = 1 + (int)(random() % 25);
+        int length = 0;
+        for (int d = 0; d < digits; d++)
+        {
+            text[length++] = (char)('0' + random() % 10);
+            if (d == 0 && digits > 1)
+            {
+                text[length++] = '.';
+            }
+        }
+        std::snprintf(text + length, sizeof(text) - length, "%c%d",
+            random() % 2 ? 'e' : 'E', (int)(random() % 661) - 340);
+        checked++;
+        failed += same_as_strtod(text) ? 0 : 1;
+    }
+
+    std::cout << "numbers checked against strtod:" << checked
+        << " differ:" << failed << std::endl;
+
+    // number beyond double range is read by strtold where long double is
+    // wider, and written with its digits instead of null
+    JsonW beyond("[1e400,-2.5e4000,1.18973149535723176502e+4932]");
+    if (beyond.valid())
+    {
+        std::string text = beyond.text();
+        JsonW again(text.c_str());
+
+        bool same = again.valid() && again.size() == 3;
+        for (size_t i = 0; same && i < 3; i++)
+        {
+            same = again[i].type() == JsonW::FLOAT && again[i].frac() == beyond[i].frac();
+        }
+
+        // neither MessagePack nor CBOR holds them, nothing is encoded
+        std::vector<uint8_t> frame(4);
+        same = same && beyond.to_msgpack().empty() && !beyond.to_cbor(frame) && frame.size() == 4;
+
+        std::cout << text << " read again " << (same ? "ok" : "FAILED") << std::endl;
+    }
+}
+
+// number - time to read a number heavy array, compared with strtod
+void how_fast_numbers_are_read()
+{
+    const int count = 200000;
+
+    // doubles in shortest round-trip form, short decimals and integers
+    std::mt19937_64 random(20231017);
+    std::string text = "[";
+    char number[32];
+
+    for (int i = 0; i < count; i++)
+    {
+        uint64_t bits = random() & 0x7FEFFFFFFFFFFFFFULL;
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+
+        switch (i % 3)
+        {
+        case 0:
+            std::snprintf(number, sizeof(number), "%.17g", value);
+            break;
+        case 1:
+            std::snprintf(number, sizeof(number), "%.2f", (double)(random() % 100000) / 100);
+            break;
+        default:
+            std::snprintf(number, sizeof(number), "%lld", (long long)(random() >> 1));
+            break;
+        }
+
+        text += (i > 0 ? "," : "");
+        text += number;
+    }
+    text += "]";
+
+    auto start = std::chrono::steady_clock::now();
+    JsonU8 json(text.data(), text.size());
+    auto parsed = std::chrono::steady_clock::now();
+
+    // strtod over the same text, skipping the separators
+    size_t values = 0;
+    for (const char* cur = text.c_str() + 1; *cur != '\0'; cur++)
+    {
+        char* end;
+        std::strtod(cur, &end);
+        values += end > cur ? 1 : 0;
+        cur = end;
+    }
+    auto scanned = std::chrono::steady_clock::now();
+
+    long long jsonus = (long long)std::chrono::duration_cast<std::chrono::microseconds>(parsed - start).count();
+    long long strtodus = (long long)std::chrono::duration_cast<std::chrono::microseconds>(scanned - parsed).count();
+
+    std::cout << "numbers read:" << (json.valid() ? json.size() : 0) << "/" << values
+        << " of " << text.size() << " bytes json:" << jsonus << "us strtod:" << strtodus << "us" << std::endl;
+}
+
+// struct binding - unsigned 64 bit member keeps its full range
+void bind_unsigned_64_bit_number()
+{
+    Counter counter;
+    counter.count = UINT64_MAX;
+    counter.samples.push_back(0);
+    counter.samples.push_back((uint64_t)INT64_MAX + 1);
+
+    std::string text = JsonBindW::text(counter);
+
+    Counter again;
+    bool same = JsonBindW::parse(text, again) && again.count == UINT64_MAX &&
+        again.samples.size() == 2 && again.samples[1] == (uint64_t)INT64_MAX + 1;
+
+    // one above UINT64_MAX and a negative number do not fit
+    Counter bad;
+    same = same && !JsonBindW::parse("{\"count\":18446744073709551616}", bad) &&
+        !JsonBindW::parse("{\"count\":-1}", bad);
+
+    std::cout << text << " read again " << (same ? "ok" : "FAILED") << std::endl;
+}
+
+// struct binding - text that JsonW does not read is not bound either
+void bind_rejected_members()
+{
+    Reading reading;
+    bool same = JsonBindW::parse("{\"level\":1e38,\"small\":1}", reading) && reading.small == 1;
+
+    // float above the range of the member, duplicate key, bound or not
+    same = same && !JsonBindW::parse("{\"level\":1e300}", reading) &&
+        !JsonBindW::parse("{\"small\":1,\"small\":2}", reading) &&
+        !JsonBindW::parse("{\"other\":1,\"other\":2}", reading) &&
+        !JsonW("{\"small\":1,\"small\":2}").valid();
+
+    std::cout << "bind rejected members " << (same ? "ok" : "FAILED") << std::endl;
 }
\ No newline at end of file